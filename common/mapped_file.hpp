@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace detail {
+// throws std::system_error for the last OS error, naming the file
+[[noreturn]] inline void fileFailure(const char* what, const std::filesystem::path& path) {
+#ifdef _WIN32
+    const int error = static_cast<int>(GetLastError());
+#else
+    const int error = errno;
+#endif
+    throw std::system_error(error, std::system_category(), what + (" " + path.string()));
+}
+}  // namespace detail
+
+// Read-only view of a whole file through a memory mapping, so its bytes
+// are read in by the OS on first touch instead of copied. The mapping
+// outlives closing the file. With sequential, the OS is told the file will
+// be read front to back and reads ahead more eagerly. Move-only.
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(const std::filesystem::path& path, bool sequential = false) {
+#ifdef _WIN32
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING,
+                                  sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL,
+                                  nullptr);
+        if (file == INVALID_HANDLE_VALUE) detail::fileFailure("Cannot open", path);
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            CloseHandle(file);
+            detail::fileFailure("Cannot stat", path);
+        }
+        m_size = static_cast<std::size_t>(size.QuadPart);
+        if (m_size > 0) {
+            HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping) {
+                m_data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                CloseHandle(mapping);
+            }
+            if (!m_data) {
+                CloseHandle(file);
+                detail::fileFailure("Cannot map", path);
+            }
+        }
+        CloseHandle(file);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) detail::fileFailure("Cannot open", path);
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            detail::fileFailure("Cannot stat", path);
+        }
+        m_size = static_cast<std::size_t>(info.st_size);
+        if (m_size > 0) {
+            void* addr = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (addr == MAP_FAILED) {
+                ::close(fd);
+                detail::fileFailure("Cannot map", path);
+            }
+            if (sequential) ::madvise(addr, m_size, MADV_SEQUENTIAL);
+            m_data = static_cast<const char*>(addr);
+        }
+        ::close(fd);
+#endif
+    }
+
+    MappedFile(MappedFile&& other) noexcept
+        : m_data{std::exchange(other.m_data, nullptr)}, m_size{std::exchange(other.m_size, 0)} {}
+
+    MappedFile& operator=(MappedFile other) noexcept {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        return *this;
+    }
+
+    ~MappedFile() {
+        if (!m_data) return;
+#ifdef _WIN32
+        UnmapViewOfFile(m_data);
+#else
+        ::munmap(const_cast<char*>(m_data), m_size);
+#endif
+    }
+
+    const char* data() const {
+        return m_data;
+    }
+
+    std::size_t size() const {
+        return m_size;
+    }
+
+    std::string_view view() const {
+        return {m_data, m_size};
+    }
+
+private:
+    const char* m_data{nullptr};
+    std::size_t m_size{0};
+};
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#if defined(__AVX2__) || defined(__SSE4_1__) || defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+#include "./date.hpp"
+
+// Bulk conversions between day counts since 1970-01-01 and year/month/day
+// columns. The kernels follow Neri & Schneider, "Euclidean affine functions
+// and their application to calendar algorithms": every division is by a
+// constant and becomes a multiply-high and a shift, so whole registers of
+// dates are converted at once. Results equal Date's for day counts in
+// [batch::MIN_DAYS, batch::MAX_DAYS], i.e. from year -32800 to 2906945.
+namespace batch {
+constexpr std::int32_t MIN_DAYS{-12699422};
+constexpr std::int32_t MAX_DAYS{1061020390};
+
+namespace detail {
+// shift the epoch by 82 eras so every intermediate value is unsigned
+constexpr std::uint32_t K{719468 + 146097 * 82};
+constexpr std::uint32_t L{400 * 82};
+
+constexpr void civilFromDays(std::int32_t days, int& year, int& month, int& day) {
+    const std::uint32_t n = static_cast<std::uint32_t>(days) + K;
+    const std::uint32_t n1 = 4 * n + 3;
+    const std::uint32_t c = n1 / 146097;
+    const std::uint32_t nc = n1 % 146097 / 4;
+    const std::uint32_t n2 = 4 * nc + 3;
+    const std::uint32_t z = static_cast<std::uint32_t>((std::uint64_t{2939745} * n2) >> 32);
+    const std::uint32_t ny = nc - 365 * z - z / 4;
+    const std::uint32_t n3 = 2141 * ny + 197913;
+    const std::uint32_t j = ny >= 306;
+    year = static_cast<int>(100 * c + z - L + j);
+    month = static_cast<int>(j ? (n3 >> 16) - 12 : n3 >> 16);
+    day = static_cast<int>((n3 & 0xffff) / 2141 + 1);
+}
+
+constexpr std::int32_t daysFromCivil(int year, int month, int day) {
+    const std::uint32_t j = month <= 2;
+    const std::uint32_t y = static_cast<std::uint32_t>(year) + L - j;
+    const std::uint32_t m = j ? month + 12 : month;
+    const std::uint32_t c = y / 100;
+    const std::uint32_t ystar = 1461 * y / 4 - c + c / 4;
+    const std::uint32_t mstar = (979 * m - 2919) / 32;
+    return static_cast<std::int32_t>(ystar + mstar + day - 1 - K);
+}
+
+constexpr int weekDay(std::int32_t days) {
+    // K is 1 (mod 7), so (days + 4) mod 7 == (days + K + 3) mod 7
+    return static_cast<int>((static_cast<std::uint32_t>(days) + K + 3) % 7);
+}
+
+#if defined(__AVX2__)
+struct Avx2 {
+    using reg = __m256i;
+    static constexpr std::size_t WIDTH{8};
+
+    static reg load(const void* p) {
+        return _mm256_loadu_si256(static_cast<const reg*>(p));
+    }
+    static void store(void* p, reg a) {
+        _mm256_storeu_si256(static_cast<reg*>(p), a);
+    }
+    static reg set(std::uint32_t x) {
+        return _mm256_set1_epi32(static_cast<int>(x));
+    }
+    static reg add(reg a, reg b) {
+        return _mm256_add_epi32(a, b);
+    }
+    static reg sub(reg a, reg b) {
+        return _mm256_sub_epi32(a, b);
+    }
+    static reg mullo(reg a, reg b) {
+        return _mm256_mullo_epi32(a, b);
+    }
+    static reg mulhi(reg a, reg b) {
+        const reg even = _mm256_srli_epi64(_mm256_mul_epu32(a, b), 32);
+        const reg odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+        return _mm256_blend_epi32(even, odd, 0b10101010);
+    }
+    template <int N>
+    static reg sll(reg a) {
+        return _mm256_slli_epi32(a, N);
+    }
+    template <int N>
+    static reg srl(reg a) {
+        return _mm256_srli_epi32(a, N);
+    }
+    static reg and_(reg a, reg b) {
+        return _mm256_and_si256(a, b);
+    }
+    static reg gt(reg a, reg b) {
+        return _mm256_cmpgt_epi32(a, b);
+    }
+};
+using Simd = Avx2;
+#elif defined(__SSE4_1__) || defined(__AVX__)
+struct Sse41 {
+    using reg = __m128i;
+    static constexpr std::size_t WIDTH{4};
+
+    static reg load(const void* p) {
+        return _mm_loadu_si128(static_cast<const reg*>(p));
+    }
+    static void store(void* p, reg a) {
+        _mm_storeu_si128(static_cast<reg*>(p), a);
+    }
+    static reg set(std::uint32_t x) {
+        return _mm_set1_epi32(static_cast<int>(x));
+    }
+    static reg add(reg a, reg b) {
+        return _mm_add_epi32(a, b);
+    }
+    static reg sub(reg a, reg b) {
+        return _mm_sub_epi32(a, b);
+    }
+    static reg mullo(reg a, reg b) {
+        return _mm_mullo_epi32(a, b);
+    }
+    static reg mulhi(reg a, reg b) {
+        const reg even = _mm_srli_epi64(_mm_mul_epu32(a, b), 32);
+        const reg odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+        return _mm_blend_epi16(even, odd, 0b11001100);
+    }
+    template <int N>
+    static reg sll(reg a) {
+        return _mm_slli_epi32(a, N);
+    }
+    template <int N>
+    static reg srl(reg a) {
+        return _mm_srli_epi32(a, N);
+    }
+    static reg and_(reg a, reg b) {
+        return _mm_and_si128(a, b);
+    }
+    static reg gt(reg a, reg b) {
+        return _mm_cmpgt_epi32(a, b);
+    }
+};
+using Simd = Sse41;
+#endif
+
+#if defined(__AVX2__) || defined(__SSE4_1__) || defined(__AVX__)
+// same steps as the scalar versions above, one register of dates at a time
+template <typename V>
+std::size_t civilFromDays(const std::int32_t* days, int* years, int* months, int* mdays,
+                          std::size_t n) {
+    std::size_t i{0};
+    for (; i + V::WIDTH <= n; i += V::WIDTH) {
+        const auto nn = V::add(V::load(days + i), V::set(K));
+        const auto n1 = V::add(V::template sll<2>(nn), V::set(3));
+        const auto c = V::template srl<15>(V::mulhi(n1, V::set(963315389)));  // n1 / 146097
+        const auto nc = V::template srl<2>(V::sub(n1, V::mullo(c, V::set(146097))));
+        const auto n2 = V::add(V::template sll<2>(nc), V::set(3));
+        const auto z = V::mulhi(n2, V::set(2939745));  // n2 / 1461
+        const auto ny = V::sub(V::sub(nc, V::mullo(z, V::set(365))), V::template srl<2>(z));
+        const auto n3 = V::add(V::mullo(ny, V::set(2141)), V::set(197913));
+        const auto j = V::gt(ny, V::set(305));  // all ones when ny >= 306
+        const auto y = V::add(V::mullo(c, V::set(100)), z);
+        const auto d = V::template srl<26>(V::mullo(V::and_(n3, V::set(0xffff)), V::set(31345)));
+        V::store(years + i, V::sub(V::sub(y, V::set(L)), j));
+        V::store(months + i, V::sub(V::template srl<16>(n3), V::and_(j, V::set(12))));
+        V::store(mdays + i, V::add(d, V::set(1)));
+    }
+    return i;
+}
+
+template <typename V>
+std::size_t daysFromCivil(const int* years, const int* months, const int* mdays,
+                          std::int32_t* days, std::size_t n) {
+    std::size_t i{0};
+    for (; i + V::WIDTH <= n; i += V::WIDTH) {
+        const auto m0 = V::load(months + i);
+        const auto j = V::gt(V::set(3), m0);  // all ones when month <= 2
+        const auto y = V::add(V::add(V::load(years + i), V::set(L)), j);
+        const auto m = V::add(m0, V::and_(j, V::set(12)));
+        const auto c = V::template srl<5>(V::mulhi(y, V::set(1374389535)));  // y / 100
+        const auto ystar = V::add(V::sub(V::template srl<2>(V::mullo(y, V::set(1461))), c),
+                                  V::template srl<2>(c));
+        const auto mstar = V::template srl<5>(V::sub(V::mullo(m, V::set(979)), V::set(2919)));
+        const auto dd = V::sub(V::load(mdays + i), V::set(1));
+        V::store(days + i, V::sub(V::add(V::add(ystar, mstar), dd), V::set(K)));
+    }
+    return i;
+}
+
+template <typename V>
+std::size_t weekDays(const std::int32_t* days, int* out, std::size_t n) {
+    std::size_t i{0};
+    for (; i + V::WIDTH <= n; i += V::WIDTH) {
+        const auto x = V::add(V::load(days + i), V::set(K + 3));
+        const auto q = V::template srl<2>(V::mulhi(x, V::set(2454267027)));  // x / 7
+        V::store(out + i, V::sub(x, V::mullo(q, V::set(7))));
+    }
+    return i;
+}
+#endif
+}  // namespace detail
+
+// days[i] -> (years[i], months[i], mdays[i])
+inline void civilFromDays(std::span<const std::int32_t> days, std::span<int> years,
+                          std::span<int> months, std::span<int> mdays) {
+    assert(years.size() >= days.size() && months.size() >= days.size() &&
+           mdays.size() >= days.size());
+    std::size_t i{0};
+#if defined(__AVX2__) || defined(__SSE4_1__) || defined(__AVX__)
+    i = detail::civilFromDays<detail::Simd>(days.data(), years.data(), months.data(),
+                                            mdays.data(), days.size());
+#endif
+    for (; i < days.size(); ++i) {
+        detail::civilFromDays(days[i], years[i], months[i], mdays[i]);
+    }
+}
+
+// civilFromDays for day counts of any value: when days holds one outside
+// [MIN_DAYS, MAX_DAYS], the whole span takes the scalar Date conversion
+inline void civilFromAnyDays(std::span<const std::int32_t> days, std::span<int> years,
+                             std::span<int> months, std::span<int> mdays) {
+    if (days.empty()) return;
+    const auto [lo, hi] = std::ranges::minmax(days);
+    if (lo >= MIN_DAYS && hi <= MAX_DAYS) {
+        civilFromDays(days, years, months, mdays);
+        return;
+    }
+    assert(years.size() >= days.size() && months.size() >= days.size() &&
+           mdays.size() >= days.size());
+    for (std::size_t i{0}; i < days.size(); ++i) {
+        const auto [y, m, d] = ::detail::civilFromDays(days[i]);
+        years[i] = y;
+        months[i] = m;
+        mdays[i] = d;
+    }
+}
+
+// (years[i], months[i], mdays[i]) -> days[i]
+inline void daysFromCivil(std::span<const int> years, std::span<const int> months,
+                          std::span<const int> mdays, std::span<std::int32_t> days) {
+    assert(months.size() >= years.size() && mdays.size() >= years.size() &&
+           days.size() >= years.size());
+    std::size_t i{0};
+#if defined(__AVX2__) || defined(__SSE4_1__) || defined(__AVX__)
+    i = detail::daysFromCivil<detail::Simd>(years.data(), months.data(), mdays.data(),
+                                            days.data(), years.size());
+#endif
+    for (; i < years.size(); ++i) {
+        days[i] = detail::daysFromCivil(years[i], months[i], mdays[i]);
+    }
+}
+
+// days[i] -> weekday in [0, 6], 0 being Sunday as in Date::weekDay; days
+// must lie in [MIN_DAYS, MAX_DAYS]
+inline void weekDays(std::span<const std::int32_t> days, std::span<int> out) {
+    assert(out.size() >= days.size());
+    std::size_t i{0};
+#if defined(__AVX2__) || defined(__SSE4_1__) || defined(__AVX__)
+    i = detail::weekDays<detail::Simd>(days.data(), out.data(), days.size());
+#endif
+    for (; i < days.size(); ++i) {
+        out[i] = detail::weekDay(days[i]);
+    }
+}
+
+// weekDays for day counts of any value: when days holds one outside
+// [MIN_DAYS, MAX_DAYS], the whole span takes the scalar Date conversion
+inline void weekDaysAny(std::span<const std::int32_t> days, std::span<int> out) {
+    if (days.empty()) return;
+    const auto [lo, hi] = std::ranges::minmax(days);
+    if (lo >= MIN_DAYS && hi <= MAX_DAYS) {
+        weekDays(days, out);
+        return;
+    }
+    assert(out.size() >= days.size());
+    for (std::size_t i{0}; i < days.size(); ++i) {
+        out[i] = ::detail::weekDayFromDays(days[i]);
+    }
+}
+}  // namespace batch
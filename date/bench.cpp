@@ -0,0 +1,181 @@
+// Micro-benchmarks for the Date engines. Every operation is timed on dates
+// around several base years, so a cost that grows with the distance from
+// 1970 shows up as a rising row. Build with optimizations, e.g.
+//     cl /std:c++latest /O2 /arch:AVX2 bench.cpp
+//     g++ -std=c++23 -O2 -march=native bench.cpp
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "./batch.hpp"
+#include "./date.hpp"
+#include "./format.hpp"
+
+namespace {
+constexpr int YEARS[]{1970, 2000, 2100, 2500, 5000, 9999};
+constexpr std::size_t N{1 << 14};
+constexpr auto MIN_TIME = std::chrono::milliseconds{50};
+
+// results are folded in here so the compiler cannot drop the timed work
+std::uint64_t sink;
+
+struct Input {
+    std::vector<Date> dates;
+    std::vector<CompactDate> compact;
+    std::vector<std::int32_t> days;
+    std::vector<int> years, months, mdays, offsets, out;
+};
+
+// N dates spread over the two years after base
+Input makeInput(int base) {
+    Input in;
+    const Date start{base};
+    std::uint32_t seed{12345};
+    for (std::size_t i{0}; i < N; ++i) {
+        seed = seed * 1664525 + 1013904223;
+        const Date d = start + seed % 730;
+        in.dates.push_back(d);
+        in.compact.push_back(CompactDate{d});
+        in.days.push_back(in.compact.back().days());
+        in.years.push_back(d.year);
+        in.months.push_back(d.month);
+        in.mdays.push_back(d.day);
+        in.offsets.push_back(static_cast<int>(seed >> 16) % 1000);
+    }
+    in.out.resize(N);
+    return in;
+}
+
+// runs body (which does N operations) until MIN_TIME has passed; ns per operation
+double measure(const std::function<void()>& body) {
+    using clock = std::chrono::steady_clock;
+    body();  // warm-up
+    std::size_t rounds{0};
+    const auto start = clock::now();
+    auto now = start;
+    do {
+        body();
+        ++rounds;
+        now = clock::now();
+    } while (now - start < MIN_TIME);
+    return std::chrono::duration<double, std::nano>(now - start).count() / (rounds * N);
+}
+
+struct Case {
+    const char* name;
+    std::function<void(Input&)> body;
+};
+
+const std::vector<Case> CASES{
+    {"Date(y, m, d)",
+     [](Input& in) {
+         // Date only stores its fields, so its days since 1970 are taken
+         // as well, like CompactDate does on construction
+         const Date epoch{1970};
+         std::uint64_t acc{0};
+         for (std::size_t i{0}; i < N; ++i) {
+             const Date d{in.years[i], in.months[i], in.mdays[i]};
+             acc += d - epoch;
+         }
+         sink += acc;
+     }},
+    {"Date - Date",
+     [](Input& in) {
+         std::int64_t acc{0};
+         for (std::size_t i{0}; i < N; ++i) acc += in.dates[i] - in.dates[N - 1 - i];
+         sink += acc;
+     }},
+    {"Date + int",
+     [](Input& in) {
+         std::uint64_t acc{0};
+         for (std::size_t i{0}; i < N; ++i) acc += (in.dates[i] + in.offsets[i]).day;
+         sink += acc;
+     }},
+    {"Date.weekDay()",
+     [](Input& in) {
+         std::uint64_t acc{0};
+         for (std::size_t i{0}; i < N; ++i) acc += in.dates[i].weekDay();
+         sink += acc;
+     }},
+    {"ostream << Date",
+     [](Input& in) {
+         std::ostringstream os;
+         for (std::size_t i{0}; i < N; ++i) os << in.dates[i] << '\n';
+         sink += os.str().size();
+     }},
+    {"formatIso(Date)",
+     [](Input& in) {
+         char buf[32];
+         std::uint64_t acc{0};
+         for (std::size_t i{0}; i < N; ++i) {
+             acc += formatIso(buf, buf + 32, in.dates[i]).ptr - buf;
+         }
+         sink += acc + buf[9];
+     }},
+    {"CompactDate(y, m, d)",
+     [](Input& in) {
+         std::uint64_t acc{0};
+         for (std::size_t i{0}; i < N; ++i) {
+             acc += CompactDate{in.years[i], in.months[i], in.mdays[i]}.days();
+         }
+         sink += acc;
+     }},
+    {"CompactDate + int",
+     [](Input& in) {
+         std::uint64_t acc{0};
+         for (std::size_t i{0}; i < N; ++i) acc += (in.compact[i] + in.offsets[i]).days();
+         sink += acc;
+     }},
+    {"CompactDate.toDate()",
+     [](Input& in) {
+         std::uint64_t acc{0};
+         for (std::size_t i{0}; i < N; ++i) acc += in.compact[i].toDate().day;
+         sink += acc;
+     }},
+    {"batch::civilFromDays",
+     [](Input& in) {
+         batch::civilFromDays(in.days, in.years, in.months, in.mdays);
+         sink += in.years[N / 2];
+     }},
+    {"batch::daysFromCivil",
+     [](Input& in) {
+         batch::daysFromCivil(in.years, in.months, in.mdays, in.days);
+         sink += in.days[N / 2];
+     }},
+    {"batch::weekDays",
+     [](Input& in) {
+         batch::weekDays(in.days, in.out);
+         sink += in.out[N / 2];
+     }},
+};
+}  // namespace
+
+int main() {
+    std::vector<Input> inputs;
+    for (const int year : YEARS) inputs.push_back(makeInput(year));
+
+    std::printf("%-22s", "ns/op");
+    for (const int year : YEARS) std::printf("%9d", year);
+    std::printf("%9s\n", "max/min");
+
+    for (const auto& c : CASES) {
+        std::printf("%-22s", c.name);
+        double lo{1e300}, hi{0};
+        for (auto& in : inputs) {
+            const double ns = measure([&] { c.body(in); });
+            lo = std::min(lo, ns);
+            hi = std::max(hi, ns);
+            std::printf("%9.2f", ns);
+        }
+        // a ratio near 1 means the cost does not depend on the year
+        std::printf("%9.2f\n", hi / lo);
+    }
+    std::fprintf(stderr, "checksum %llu\n", static_cast<unsigned long long>(sink));
+    return 0;
+}
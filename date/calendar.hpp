@@ -0,0 +1,162 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "./date.hpp"
+
+// Business-day arithmetic over Date. A day is a business day when its
+// weekDay() is not in the weekend mask and it is not a holiday.
+//
+// Holidays live in one bitset per year (indexed by dayOfYear() - 1), next to
+// a running count of holidays in all earlier years. Counting business days
+// between two dates is then a closed-form weekday count minus two prefix
+// popcounts, and adding N business days is a search over that count, so no
+// operation walks the calendar day by day.
+class BusinessCalendar {
+public:
+    // bit w set means weekDay() == w is a day off; 0 is Sunday
+    static constexpr unsigned SATURDAY_SUNDAY{(1u << 0) | (1u << 6)};
+
+    explicit BusinessCalendar(unsigned weekendMask = SATURDAY_SUNDAY)
+        : m_weekend{weekendMask & 0x7f} {
+        if (m_weekend == 0x7f) {
+            throw std::invalid_argument("A week needs at least one business day");
+        }
+        // m_partial[r] = business weekdays among the r days from 1970-01-01 (a Thursday)
+        for (int r{0}; r < 7; ++r) {
+            m_partial[r + 1] = m_partial[r] + (isWeekend(r) ? 0 : 1);
+        }
+    }
+
+    // Holidays on a weekend change nothing and are not stored.
+    void addHoliday(const Date& date) {
+        setHoliday(date, true);
+    }
+
+    void removeHoliday(const Date& date) {
+        setHoliday(date, false);
+    }
+
+    bool isHoliday(const Date& date) const {
+        const YearHolidays* y = find(date.year);
+        return y && y->bits[date.dayOfYear() - 1];
+    }
+
+    bool isBusinessDay(const Date& date) const {
+        return !isWeekend(daysOf(date)) && !isHoliday(date);
+    }
+
+    // number of business days in [from, to), negative when to < from
+    std::int64_t businessDaysBetween(const Date& from, const Date& to) const {
+        return rank(daysOf(to)) - rank(daysOf(from));
+    }
+
+    // The business day n business days after date. With n == 0 a
+    // non-business date rolls forward to the next business day; a negative n
+    // counts backwards, so subBusinessDays(addBusinessDays(d, n), n) == d for
+    // every business day d.
+    Date addBusinessDays(const Date& date, std::int64_t n) const {
+        const std::int64_t target = rank(daysOf(date)) + n + 1;
+        // rank() is non-decreasing: bracket the first day whose rank reaches
+        // target, starting from the no-holiday estimate, then bisect
+        std::int64_t guess = daysOf(date) + n * 7 / m_partial[7];
+        std::int64_t lo, hi;
+        if (rank(guess) >= target) {
+            hi = guess;
+            for (std::int64_t step{7};; step *= 2) {
+                lo = hi - step;
+                if (rank(lo) < target) break;
+                hi = lo;
+            }
+        } else {
+            lo = guess;
+            for (std::int64_t step{7};; step *= 2) {
+                hi = lo + step;
+                if (rank(hi) >= target) break;
+                lo = hi;
+            }
+        }
+        while (hi - lo > 1) {
+            const std::int64_t mid = lo + (hi - lo) / 2;
+            (rank(mid) >= target ? hi : lo) = mid;
+        }
+        return Date{1970} + (hi - 1);
+    }
+
+    Date subBusinessDays(const Date& date, std::int64_t n) const {
+        return addBusinessDays(date, -n);
+    }
+
+private:
+    struct YearHolidays {
+        std::bitset<366> bits;
+        int before{0};  // holidays stored for all earlier years
+    };
+
+    static std::int64_t daysOf(const Date& date) {
+        return date - Date{1970};
+    }
+
+    static std::int64_t floorDiv7(std::int64_t days) {
+        return (days >= 0 ? days : days - 6) / 7;
+    }
+
+    bool isWeekend(std::int64_t days) const {
+        return m_weekend >> detail::weekDayFromDays(days) & 1;
+    }
+
+    const YearHolidays* find(int year) const {
+        const int i = year - m_firstYear;
+        return i >= 0 && i < static_cast<int>(m_years.size()) ? &m_years[i] : nullptr;
+    }
+
+    // business days in [1970-01-01, days), negative before the epoch
+    std::int64_t rank(std::int64_t days) const {
+        const std::int64_t weeks = floorDiv7(days);
+        const std::int64_t workdays = weeks * m_partial[7] + m_partial[days - weeks * 7];
+        return workdays - holidaysBefore(days);
+    }
+
+    int holidaysBefore(std::int64_t days) const {
+        if (m_years.empty()) return 0;
+        const auto [y, m, d] = detail::civilFromDays(days);
+        if (y < m_firstYear) return 0;
+        if (y >= m_firstYear + static_cast<int>(m_years.size())) return m_total;
+        const YearHolidays& year = m_years[y - m_firstYear];
+        const int doy = daysBeforeMonth(y, m) + d - 1;
+        return year.before + static_cast<int>((year.bits << (366 - doy)).count());
+    }
+
+    void setHoliday(const Date& date, bool on) {
+        if (on && isWeekend(daysOf(date))) return;
+        if (!on && !find(date.year)) return;
+        if (m_years.empty()) {
+            m_firstYear = date.year;
+            m_years.resize(1);
+        } else if (date.year < m_firstYear) {
+            m_years.insert(m_years.begin(), m_firstYear - date.year, YearHolidays{});
+            m_firstYear = date.year;
+        } else if (date.year >= m_firstYear + static_cast<int>(m_years.size())) {
+            m_years.resize(date.year - m_firstYear + 1, YearHolidays{{}, m_total});
+        }
+        const std::size_t i = date.year - m_firstYear;
+        auto bit = m_years[i].bits[date.dayOfYear() - 1];
+        if (bit == on) return;
+        bit = on;
+        const int delta = on ? 1 : -1;
+        for (std::size_t j = i + 1; j < m_years.size(); ++j) {
+            m_years[j].before += delta;
+        }
+        m_total += delta;
+    }
+
+    unsigned m_weekend;
+    int m_partial[8]{};
+    int m_firstYear{0};
+    int m_total{0};
+    std::vector<YearHolidays> m_years;
+};
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "./batch.hpp"
+#include "./date.hpp"
+
+// A column of dates stored as contiguous day counts since 1970-01-01 (the
+// CompactDate representation). Sorting, grouping and filtering work on the
+// integers directly: grouping decomposes a block at a time through the
+// batch kernels, so no Date is ever built. A block holding a day outside
+// [batch::MIN_DAYS, batch::MAX_DAYS] is decomposed one day at a time.
+class DateColumn {
+public:
+    struct YearCounts {
+        int firstYear;
+        std::vector<std::size_t> counts;  // counts[i] is for firstYear + i
+    };
+
+    DateColumn() = default;
+    explicit DateColumn(std::vector<std::int32_t> days) : m_days{std::move(days)} {}
+
+    std::size_t size() const {
+        return m_days.size();
+    }
+
+    void reserve(std::size_t n) {
+        m_days.reserve(n);
+    }
+
+    void push_back(CompactDate date) {
+        m_days.push_back(date.days());
+        m_sorted = false;
+    }
+
+    CompactDate operator[](std::size_t index) const {
+        return CompactDate::fromDays(m_days[index]);
+    }
+
+    std::span<const std::int32_t> days() const {
+        return m_days;
+    }
+
+    // LSD radix sort, one pass per byte; passes where every key has the same
+    // byte are skipped
+    void sort() {
+        if (m_sorted) return;
+        const std::size_t n = m_days.size();
+        std::vector<std::uint32_t> keys(n), buffer(n);
+        for (std::size_t i{0}; i < n; ++i) {
+            keys[i] = static_cast<std::uint32_t>(m_days[i]) ^ 0x80000000u;
+        }
+        std::array<std::array<std::size_t, 256>, 4> histograms{};
+        for (const auto key : keys) {
+            for (int b{0}; b < 4; ++b) {
+                ++histograms[b][key >> (8 * b) & 0xff];
+            }
+        }
+        for (int b{0}; b < 4; ++b) {
+            auto& histogram = histograms[b];
+            if (std::ranges::find(histogram, n) != histogram.end()) continue;
+            std::size_t offset{0};
+            for (auto& count : histogram) {
+                offset += std::exchange(count, offset);
+            }
+            for (const auto key : keys) {
+                buffer[histogram[key >> (8 * b) & 0xff]++] = key;
+            }
+            keys.swap(buffer);
+        }
+        for (std::size_t i{0}; i < n; ++i) {
+            m_days[i] = static_cast<std::int32_t>(keys[i] ^ 0x80000000u);
+        }
+        m_sorted = true;
+    }
+
+    // counts[w] for weekDay() == w, 0 being Sunday
+    std::array<std::size_t, 7> countByWeekDay() const {
+        std::array<std::size_t, 7> counts{};
+        int weekDays[BLOCK];
+        forEachBlock([&](std::span<const std::int32_t> block) {
+            batch::weekDaysAny(block, weekDays);
+            for (std::size_t i{0}; i < block.size(); ++i) ++counts[weekDays[i]];
+        });
+        return counts;
+    }
+
+    // counts[m - 1] for month m, over all years
+    std::array<std::size_t, 12> countByMonth() const {
+        std::array<std::size_t, 12> counts{};
+        int years[BLOCK], months[BLOCK], mdays[BLOCK];
+        forEachBlock([&](std::span<const std::int32_t> block) {
+            batch::civilFromAnyDays(block, years, months, mdays);
+            for (std::size_t i{0}; i < block.size(); ++i) ++counts[months[i] - 1];
+        });
+        return counts;
+    }
+
+    YearCounts countByYear() const {
+        if (m_days.empty()) return {0, {}};
+        const auto [lo, hi] = std::ranges::minmax(m_days);
+        YearCounts result{CompactDate::fromDays(lo).year(), {}};
+        result.counts.resize(CompactDate::fromDays(hi).year() - result.firstYear + 1);
+        int years[BLOCK], months[BLOCK], mdays[BLOCK];
+        forEachBlock([&](std::span<const std::int32_t> block) {
+            batch::civilFromAnyDays(block, years, months, mdays);
+            for (std::size_t i{0}; i < block.size(); ++i) {
+                ++result.counts[years[i] - result.firstYear];
+            }
+        });
+        return result;
+    }
+
+    // number of dates in [from, to); a binary search once sorted
+    std::size_t countInRange(CompactDate from, CompactDate to) const {
+        const std::int32_t lo = from.days(), hi = to.days();
+        if (m_sorted) {
+            return std::max<std::ptrdiff_t>(
+                0, std::ranges::lower_bound(m_days, hi) - std::ranges::lower_bound(m_days, lo));
+        }
+        std::size_t count{0};
+        for (const auto d : m_days) {
+            count += (d >= lo) & (d < hi);
+        }
+        return count;
+    }
+
+    // the dates in [from, to), in column order
+    DateColumn filter(CompactDate from, CompactDate to) const {
+        const std::int32_t lo = from.days(), hi = to.days();
+        DateColumn result;
+        if (m_sorted) {
+            const auto first = std::ranges::lower_bound(m_days, lo);
+            const auto last = std::max(first, std::ranges::lower_bound(m_days, hi));
+            result.m_days.assign(first, last);
+            result.m_sorted = true;
+            return result;
+        }
+        // branchless compaction: always write, advance only on a match
+        result.m_days.resize(m_days.size());
+        std::size_t n{0};
+        for (const auto d : m_days) {
+            result.m_days[n] = d;
+            n += (d >= lo) & (d < hi);
+        }
+        result.m_days.resize(n);
+        return result;
+    }
+
+private:
+    static constexpr std::size_t BLOCK{512};
+
+    template <typename F>
+    void forEachBlock(F&& f) const {
+        const std::span<const std::int32_t> all{m_days};
+        for (std::size_t i{0}; i < all.size(); i += BLOCK) {
+            f(all.subspan(i, std::min(BLOCK, all.size() - i)));
+        }
+    }
+
+    std::vector<std::int32_t> m_days;
+    bool m_sorted{false};
+};
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+constexpr bool isLeap(int y) {
+    return y % 4 == 0 && y % 100 != 0 || y % 400 == 0;
+}
+
+constexpr int numDaysOfYear(int y) {
+    return isLeap(y) ? 366 : 365;
+}
+
+// CUM_DAYS[leap][m] is the number of days in the year before month m
+inline constexpr int CUM_DAYS[2][14]{
+    {0, 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365},
+    {0, 0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335, 366},
+};
+
+constexpr int numDaysOfMonth(int y, int m) {
+    const int leap = isLeap(y) ? 1 : 0;
+    return CUM_DAYS[leap][m + 1] - CUM_DAYS[leap][m];
+}
+
+constexpr int daysBeforeMonth(int y, int m) {
+    return CUM_DAYS[isLeap(y) ? 1 : 0][m];
+}
+
+namespace detail {
+struct Civil {
+    int year;
+    int month;
+    int day;
+};
+
+// closed-form conversions on a March-based 400-year era,
+// see http://howardhinnant.github.io/date_algorithms.html
+// Day counts are 64-bit and the formulas hold for the whole proleptic
+// Gregorian calendar, i.e. every int year, before 1970 and before year 1.
+constexpr std::int64_t daysFromCivil(int year, int month, int day) {
+    const std::int64_t y = std::int64_t{year} - (month <= 2 ? 1 : 0);
+    const std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const int yoe = static_cast<int>(y - era * 400);                    // [0, 399]
+    const int mp = month > 2 ? month - 3 : month + 9;                   // [0, 11]
+    const int doy = (153 * mp + 2) / 5 + day - 1;                       // [0, 365]
+    const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;              // [0, 146096]
+    return era * 146097 + doe - 719468;
+}
+
+constexpr Civil civilFromDays(std::int64_t days) {
+    const std::int64_t z = days + 719468;
+    const std::int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const int doe = static_cast<int>(z - era * 146097);                 // [0, 146096]
+    const int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;  // [0, 399]
+    const int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);            // [0, 365]
+    const int mp = (5 * doy + 2) / 153;                                 // [0, 11]
+    const int d = doy - (153 * mp + 2) / 5 + 1;
+    const int m = mp < 10 ? mp + 3 : mp - 9;
+    return {static_cast<int>(yoe + era * 400 + (m <= 2 ? 1 : 0)), m, d};
+}
+
+// weekday of a day count, 0 being Sunday (1970-01-01 was a Thursday)
+constexpr int weekDayFromDays(std::int64_t days) {
+    const int r = static_cast<int>((days + 4) % 7);
+    return r < 0 ? r + 7 : r;
+}
+}  // namespace detail
+
+class Date {
+private:
+    constexpr std::int64_t daysFromEpoch() const {
+        return detail::daysFromCivil(this->year, this->month, this->day);
+    }
+
+    constexpr void makeFromTimestamp(std::int64_t timestamp) {
+        const auto [y, m, d] = detail::civilFromDays(timestamp);
+        this->year = y;
+        this->month = m;
+        this->day = d;
+    }
+
+    friend class CompactDate;
+
+public:
+    int year;
+    int month;
+    int day;
+
+    constexpr int weekDay() const {
+        return detail::weekDayFromDays(daysFromEpoch());
+    }
+
+    // 1-based day within the year
+    constexpr int dayOfYear() const {
+        return daysBeforeMonth(this->year, this->month) + this->day;
+    }
+
+    constexpr Date(int year, int month = 1, int day = 1) : year{year}, month{month}, day{day} {}
+
+    constexpr std::int64_t operator-(this const Date& lhs, const Date& rhs) {
+        return lhs.daysFromEpoch() - rhs.daysFromEpoch();
+    }
+
+    constexpr Date operator+(std::int64_t duration) const {
+        Date copy{*this};
+        copy.makeFromTimestamp(this->daysFromEpoch() + duration);
+        return copy;
+    }
+
+    constexpr Date operator-(std::int64_t duration) const {
+        return *this + -duration;
+    }
+
+    constexpr Date& operator+=(std::int64_t duration) {
+        return *this = *this + duration;
+    }
+
+    constexpr Date& operator-=(std::int64_t duration) {
+        return *this = *this - duration;
+    }
+};
+
+constexpr Date operator+(std::int64_t duration, const Date& base) {
+    return base + duration;
+}
+
+inline std::ostream& operator<<(std::ostream& os, const Date& rhs) {
+    return os << rhs.year << '/' << rhs.month << '/' << rhs.day;
+}
+
+// Same interface as Date, but stores only the day count since 1970-01-01.
+// Arithmetic is plain integer math; year/month/day are decomposed on read.
+// The 32-bit count covers about 5.8 million years either side of 1970; use
+// Date for anything wider.
+class CompactDate {
+public:
+    constexpr CompactDate(int year, int month = 1, int day = 1)
+        : m_days{static_cast<std::int32_t>(detail::daysFromCivil(year, month, day))} {}
+    constexpr explicit CompactDate(const Date& date)
+        : m_days{static_cast<std::int32_t>(date.daysFromEpoch())} {}
+
+    static constexpr CompactDate fromDays(std::int32_t days) {
+        CompactDate result;
+        result.m_days = days;
+        return result;
+    }
+
+    constexpr std::int32_t days() const {
+        return m_days;
+    }
+
+    constexpr int year() const {
+        return detail::civilFromDays(m_days).year;
+    }
+
+    constexpr int month() const {
+        return detail::civilFromDays(m_days).month;
+    }
+
+    constexpr int day() const {
+        return detail::civilFromDays(m_days).day;
+    }
+
+    // decompose once when all three fields are needed
+    constexpr Date toDate() const {
+        const auto [y, m, d] = detail::civilFromDays(m_days);
+        return Date{y, m, d};
+    }
+
+    constexpr explicit operator Date() const {
+        return toDate();
+    }
+
+    constexpr int weekDay() const {
+        return detail::weekDayFromDays(m_days);
+    }
+
+    // computed in 64 bits: two CompactDates may be more than 2^31 days apart
+    constexpr std::int64_t operator-(this const CompactDate& lhs, const CompactDate& rhs) {
+        return std::int64_t{lhs.m_days} - rhs.m_days;
+    }
+
+    // throw std::out_of_range when the result leaves the 32-bit day count
+    constexpr CompactDate operator+(std::int64_t duration) const {
+        return fromDays(shifted(m_days, duration));
+    }
+
+    constexpr CompactDate operator-(std::int64_t duration) const {
+        if (duration == std::numeric_limits<std::int64_t>::min()) {
+            throw std::out_of_range("CompactDate out of range");
+        }
+        return *this + -duration;
+    }
+
+    constexpr CompactDate& operator+=(std::int64_t duration) {
+        return *this = *this + duration;
+    }
+
+    constexpr CompactDate& operator-=(std::int64_t duration) {
+        return *this = *this - duration;
+    }
+
+    friend bool operator==(const CompactDate&, const CompactDate&) = default;
+    friend auto operator<=>(const CompactDate&, const CompactDate&) = default;
+
+private:
+    CompactDate() = default;
+
+    static constexpr std::int32_t shifted(std::int32_t days, std::int64_t duration) {
+        constexpr std::int64_t MIN{std::numeric_limits<std::int32_t>::min()};
+        constexpr std::int64_t MAX{std::numeric_limits<std::int32_t>::max()};
+        if (duration < MIN - days || duration > MAX - days) {
+            throw std::out_of_range("CompactDate out of range");
+        }
+        return static_cast<std::int32_t>(days + duration);
+    }
+
+    std::int32_t m_days;
+};
+
+static_assert(sizeof(CompactDate) == sizeof(std::int32_t));
+static_assert(Date{2022, 9, 14} - Date{1970, 1, 1} == 19249);
+static_assert((CompactDate{1970} + 10000).toDate().year == 1997);
+static_assert(Date{1600, 1, 1}.weekDay() == 6 && (Date{1970} - 1).weekDay() == 3);
+
+constexpr CompactDate operator+(std::int64_t duration, const CompactDate& base) {
+    return base + duration;
+}
+
+inline std::ostream& operator<<(std::ostream& os, const CompactDate& rhs) {
+    return os << rhs.toDate();
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+#include "./date.hpp"
+
+namespace detail {
+constexpr std::int64_t floorDiv(std::int64_t a, std::int64_t b) {
+    const std::int64_t q = a / b;
+    return q - (a % b != 0 && (a < 0) != (b < 0) ? 1 : 0);
+}
+
+constexpr int numDigits(std::int64_t x) {
+    return x < 10 ? 1 : 1 + numDigits(x / 10);
+}
+}  // namespace detail
+
+// A point in time as one signed 64-bit count of ticks since
+// 1970-01-01 00:00:00, with TicksPerSecond ticks per second. Arithmetic and
+// comparisons are integer operations; the calendar part goes through Date's
+// closed-form day conversion, so converting either way never loops.
+//
+// DateTime counts seconds (range far beyond Date's); DateTimeNs counts
+// nanoseconds and so spans 1677-09-21 to 2262-04-11.
+template <std::int64_t TicksPerSecond>
+class BasicDateTime {
+public:
+    static_assert(TicksPerSecond > 0);
+
+    static constexpr std::int64_t SECOND{TicksPerSecond};
+    static constexpr std::int64_t MINUTE{60 * SECOND};
+    static constexpr std::int64_t HOUR{60 * MINUTE};
+    static constexpr std::int64_t DAY{24 * HOUR};
+
+    constexpr BasicDateTime(const Date& date, int hour = 0, int minute = 0, int second = 0,
+                            std::int64_t subsecond = 0)
+        : m_ticks{(date - Date{1970}) * DAY + hour * HOUR + minute * MINUTE + second * SECOND +
+                  subsecond} {}
+
+    static constexpr BasicDateTime fromTicks(std::int64_t ticks) {
+        BasicDateTime result;
+        result.m_ticks = ticks;
+        return result;
+    }
+
+    constexpr std::int64_t ticks() const {
+        return m_ticks;
+    }
+
+    // whole days since 1970-01-01, rounded towards the past
+    constexpr std::int64_t days() const {
+        return detail::floorDiv(m_ticks, DAY);
+    }
+
+    constexpr Date date() const {
+        return Date{1970} + days();
+    }
+
+    constexpr int hour() const {
+        return static_cast<int>(timeOfDay() / HOUR);
+    }
+
+    constexpr int minute() const {
+        return static_cast<int>(timeOfDay() % HOUR / MINUTE);
+    }
+
+    constexpr int second() const {
+        return static_cast<int>(timeOfDay() % MINUTE / SECOND);
+    }
+
+    // ticks within the current second
+    constexpr std::int64_t subsecond() const {
+        return timeOfDay() % SECOND;
+    }
+
+    constexpr int weekDay() const {
+        return detail::weekDayFromDays(days());
+    }
+
+    // truncation towards the past, also for instants before 1970
+    constexpr BasicDateTime floorTo(std::int64_t unit) const {
+        return fromTicks(detail::floorDiv(m_ticks, unit) * unit);
+    }
+
+    constexpr BasicDateTime floorToDay() const {
+        return floorTo(DAY);
+    }
+
+    constexpr BasicDateTime floorToHour() const {
+        return floorTo(HOUR);
+    }
+
+    constexpr BasicDateTime floorToMinute() const {
+        return floorTo(MINUTE);
+    }
+
+    constexpr std::int64_t operator-(this const BasicDateTime& lhs, const BasicDateTime& rhs) {
+        return lhs.m_ticks - rhs.m_ticks;
+    }
+
+    constexpr BasicDateTime operator+(std::int64_t ticks) const {
+        return fromTicks(m_ticks + ticks);
+    }
+
+    constexpr BasicDateTime operator-(std::int64_t ticks) const {
+        return fromTicks(m_ticks - ticks);
+    }
+
+    constexpr BasicDateTime& operator+=(std::int64_t ticks) {
+        m_ticks += ticks;
+        return *this;
+    }
+
+    constexpr BasicDateTime& operator-=(std::int64_t ticks) {
+        m_ticks -= ticks;
+        return *this;
+    }
+
+    friend constexpr bool operator==(const BasicDateTime&, const BasicDateTime&) = default;
+    friend constexpr auto operator<=>(const BasicDateTime&, const BasicDateTime&) = default;
+
+    // same layout as Date's operator<<, then hh:mm:ss and the fraction if any
+    friend std::ostream& operator<<(std::ostream& os, const BasicDateTime& rhs) {
+        const char fill = os.fill('0');
+        os << rhs.date() << ' ' << std::setw(2) << rhs.hour() << ':' << std::setw(2)
+           << rhs.minute() << ':' << std::setw(2) << rhs.second();
+        if constexpr (TicksPerSecond > 1) {
+            os << '.' << std::setw(detail::numDigits(TicksPerSecond - 1)) << rhs.subsecond();
+        }
+        os.fill(fill);
+        return os;
+    }
+
+private:
+    constexpr BasicDateTime() = default;
+
+    constexpr std::int64_t timeOfDay() const {
+        return m_ticks - days() * DAY;
+    }
+
+    std::int64_t m_ticks;
+};
+
+template <std::int64_t TicksPerSecond>
+constexpr BasicDateTime<TicksPerSecond> operator+(std::int64_t ticks,
+                                                  const BasicDateTime<TicksPerSecond>& base) {
+    return base + ticks;
+}
+
+using DateTime = BasicDateTime<1>;
+using DateTimeNs = BasicDateTime<1'000'000'000>;
+
+static_assert(sizeof(DateTime) == sizeof(std::int64_t));
+static_assert((DateTime{Date{2022, 9, 14}, 13, 45} + 11 * DateTime::HOUR).date().day == 15);
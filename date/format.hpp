@@ -0,0 +1,206 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "../common/mapped_file.hpp"
+#include "./batch.hpp"
+#include "./date.hpp"
+
+// ISO-8601 calendar dates ("YYYY-MM-DD") read from and written to caller
+// buffers, in the style of std::from_chars / std::to_chars: no locale, no
+// allocation. Years outside [0, 9999] use the expanded form with a sign
+// ("-0044-03-15", "+12345-01-01"). A whole file is best fed to
+// parseIsoLines through MappedFile(path, true).view(), without copying.
+
+namespace detail {
+inline constexpr char DIGITS2[]{
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899"};
+
+inline char* write2(char* p, int x) {
+    std::memcpy(p, DIGITS2 + 2 * x, 2);
+    return p + 2;
+}
+
+inline bool isDigit(char c) {
+    return static_cast<unsigned char>(c - '0') < 10;
+}
+
+// length of the text formatIso would write for this year, without the date part
+inline std::size_t isoYearLength(int year) {
+    if (year >= 0 && year <= 9999) return 4;
+    unsigned int y = year < 0 ? 0u - static_cast<unsigned int>(year) : year;
+    std::size_t len{1};
+    for (; y >= 10; y /= 10) ++len;
+    return 1 + (len < 4 ? 4 : len);
+}
+
+// writes exactly isoYearLength(year) + 6 chars, the caller checks the space
+inline char* writeIso(char* p, int year, int month, int day) {
+    if (year >= 0 && year <= 9999) {
+        p = write2(p, year / 100);
+        p = write2(p, year % 100);
+    } else {
+        *p++ = year < 0 ? '-' : '+';
+        unsigned int y = year < 0 ? 0u - static_cast<unsigned int>(year) : year;
+        char* end = p + (isoYearLength(year) - 1);
+        for (char* q = end; q != p;) {
+            *--q = static_cast<char>('0' + y % 10);
+            y /= 10;
+        }
+        p = end;
+    }
+    *p++ = '-';
+    p = write2(p, month);
+    *p++ = '-';
+    return write2(p, day);
+}
+}  // namespace detail
+
+inline std::to_chars_result formatIso(char* first, char* last, int year, int month, int day) {
+    const std::size_t len = detail::isoYearLength(year) + 6;
+    if (static_cast<std::size_t>(last - first) < len) return {last, std::errc::value_too_large};
+    return {detail::writeIso(first, year, month, day), std::errc{}};
+}
+
+inline std::to_chars_result formatIso(char* first, char* last, const Date& value) {
+    return formatIso(first, last, value.year, value.month, value.day);
+}
+
+inline std::to_chars_result formatIso(char* first, char* last, const CompactDate& value) {
+    return formatIso(first, last, value.toDate());
+}
+
+// On success value is assigned and ptr points past the date; on failure
+// value is untouched and ec is std::errc::invalid_argument.
+inline std::from_chars_result parseIso(const char* first, const char* last, int& year,
+                                       int& month, int& day) {
+    const char* p = first;
+    const auto fail = std::from_chars_result{first, std::errc::invalid_argument};
+    bool negative{false};
+    bool expanded{false};
+    if (p != last && (*p == '+' || *p == '-')) {
+        negative = *p == '-';
+        expanded = true;
+        ++p;
+    }
+    int y{0};
+    const char* digits = p;
+    for (; p != last && detail::isDigit(*p); ++p) {
+        if (p - digits == 6) return fail;
+        y = y * 10 + (*p - '0');
+    }
+    if (p - digits < 4 || (!expanded && p - digits != 4)) return fail;
+    if (last - p < 6 || p[0] != '-' || p[3] != '-' || !detail::isDigit(p[1]) ||
+        !detail::isDigit(p[2]) || !detail::isDigit(p[4]) || !detail::isDigit(p[5])) {
+        return fail;
+    }
+    const int m = (p[1] - '0') * 10 + (p[2] - '0');
+    const int d = (p[4] - '0') * 10 + (p[5] - '0');
+    if (negative) y = -y;
+    if (m < 1 || m > 12 || d < 1 || d > numDaysOfMonth(y, m)) return fail;
+    year = y;
+    month = m;
+    day = d;
+    return {p + 6, std::errc{}};
+}
+
+inline std::from_chars_result parseIso(const char* first, const char* last, Date& value) {
+    int y, m, d;
+    const auto result = parseIso(first, last, y, m, d);
+    if (result.ec == std::errc{}) value = Date{y, m, d};
+    return result;
+}
+
+inline std::from_chars_result parseIso(const char* first, const char* last,
+                                       CompactDate& value) {
+    int y, m, d;
+    const auto result = parseIso(first, last, y, m, d);
+    if (result.ec == std::errc{}) value = CompactDate{y, m, d};
+    return result;
+}
+
+namespace detail {
+// whether the date survives parseIsoLines' 32-bit day count and formatIsoLines
+constexpr bool isoLineRoundTrips(int year, int month, int day) {
+    const std::int64_t days = daysFromCivil(year, month, day);
+    const Civil civil = civilFromDays(static_cast<std::int32_t>(days));
+    return days >= INT32_MIN && days <= INT32_MAX && civil.year == year &&
+           civil.month == month && civil.day == day;
+}
+}  // namespace detail
+
+// the extreme dates parseIso accepts
+static_assert(detail::isoLineRoundTrips(-999999, 1, 1) &&
+              detail::isoLineRoundTrips(999999, 12, 31));
+
+struct IsoLinesResult {
+    const char* ptr;
+    std::errc ec;
+    std::size_t count;
+};
+
+// Parses newline-separated dates (optionally "\r\n", trailing newline
+// optional) into day counts since 1970-01-01. Stops at the first malformed
+// line, or when out is full; ptr is where parsing stopped.
+inline IsoLinesResult parseIsoLines(std::string_view text, std::span<std::int32_t> out) {
+    const char* p = text.data();
+    const char* const last = p + text.size();
+    std::size_t count{0};
+    while (p != last) {
+        if (count == out.size()) return {p, std::errc::value_too_large, count};
+        int y, m, d;
+        const auto [next, ec] = parseIso(p, last, y, m, d);
+        if (ec != std::errc{}) return {p, ec, count};
+        p = next;
+        if (p != last && *p == '\r') ++p;
+        if (p != last) {
+            if (*p != '\n') return {p, std::errc::invalid_argument, count};
+            ++p;
+        }
+        out[count++] = static_cast<std::int32_t>(detail::daysFromCivil(y, m, d));
+    }
+    return {p, std::errc{}, count};
+}
+
+// Writes one "YYYY-MM-DD\n" line per day count. Decomposition goes through
+// the batch kernels a block at a time, or day by day for a block holding a
+// day outside their range. ptr is past the last full line written; count
+// is the number of lines.
+inline IsoLinesResult formatIsoLines(std::span<const std::int32_t> days, std::span<char> out) {
+    constexpr std::size_t BLOCK{256};
+    int years[BLOCK], months[BLOCK], mdays[BLOCK];
+    char* p = out.data();
+    char* const last = p + out.size();
+    std::size_t count{0};
+    while (count < days.size()) {
+        const std::size_t n = std::min(BLOCK, days.size() - count);
+        batch::civilFromAnyDays(days.subspan(count, n), years, months, mdays);
+        for (std::size_t i{0}; i < n; ++i) {
+            const auto [end, ec] = formatIso(p, last, years[i], months[i], mdays[i]);
+            if (ec != std::errc{} || end == last) {
+                return {p, std::errc::value_too_large, count};
+            }
+            *end = '\n';
+            p = end + 1;
+            ++count;
+        }
+    }
+    return {p, std::errc{}, count};
+}
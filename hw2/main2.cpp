@@ -1,14 +1,18 @@
-#include <concepts>
+#include <bit>
+#include <cstddef>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
 #include <string>
 
 namespace detail {
-template <std::integral Int>
-constexpr static int next_pow2(Int x) {
-    [[assume(x > 0)]];
-    return x == 1 ? 1
-                  : 1 << (CHAR_BIT * sizeof(Int) -
-                          std::countl_zero(static_cast<std::make_unsigned_t<Int>>(x - 1)));
+// smallest power of two not less than x; throws rather than wrap around
+constexpr std::size_t next_pow2(std::size_t x) {
+    if (x > std::bit_floor(std::numeric_limits<std::size_t>::max())) {
+        throw std::length_error("Vector too large");
+    }
+    return std::bit_ceil(x);
 }
 }  // namespace detail
 
@@ -16,14 +20,17 @@ template <typename T>
 struct Vector {
 public:
     Vector() : m_data{}, m_capacity{}, m_size{} {}
-    Vector(int size) : Vector(size, T{}) {}
-    Vector(int size, const T& value) {
+    Vector(std::size_t size) : Vector(size, T{}) {}
+    Vector(std::size_t size, const T& value) {
         m_size = size;
         if (size > 0) {
             m_capacity = detail::next_pow2(size);
-            m_data = new T[m_capacity];
-            for (int i{0}; i < m_capacity; i++) {
-                m_data[i] = value;
+            m_data = std::allocator<T>{}.allocate(m_capacity);
+            try {
+                std::uninitialized_fill_n(m_data, m_size, value);
+            } catch (...) {
+                std::allocator<T>{}.deallocate(m_data, m_capacity);
+                throw;
             }
         } else {
             m_capacity = 0;
@@ -34,22 +41,26 @@ public:
         m_size = other.m_size;
         m_capacity = other.m_capacity;
         if (m_capacity > 0) {
-            m_data = new T[m_capacity];
-            for (int i{0}; i < m_capacity; i++) {
-                m_data[i] = other.m_data[i];
+            m_data = std::allocator<T>{}.allocate(m_capacity);
+            try {
+                std::uninitialized_copy_n(other.m_data, m_size, m_data);
+            } catch (...) {
+                std::allocator<T>{}.deallocate(m_data, m_capacity);
+                throw;
             }
         } else {
             m_data = nullptr;
         }
     }
     ~Vector() {
-        delete[] m_data;
+        std::destroy_n(m_data, m_size);
+        if (m_data) std::allocator<T>{}.deallocate(m_data, m_capacity);
     }
 
 private:
     T* m_data;
-    int m_capacity;
-    int m_size;
+    std::size_t m_capacity;
+    std::size_t m_size;
 };
 
 int main() {
@@ -1,15 +1,20 @@
-#include <concepts>
+#include <bit>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 
 namespace detail {
-template <std::integral Int>
-constexpr static int next_pow2(Int x) {
-    [[assume(x > 0)]];
-    return x == 1 ? 1
-                  : 1 << (CHAR_BIT * sizeof(Int) -
-                          std::countl_zero(static_cast<std::make_unsigned_t<Int>>(x - 1)));
+// smallest power of two not less than x; throws rather than wrap around
+constexpr std::size_t next_pow2(std::size_t x) {
+    if (x > std::bit_floor(std::numeric_limits<std::size_t>::max())) {
+        throw std::length_error("Vector too large");
+    }
+    return std::bit_ceil(x);
 }
 }  // namespace detail
 
@@ -17,14 +22,17 @@ template <typename T>
 struct Vector {
 public:
     Vector() : m_data{}, m_capacity{}, m_size{} {}
-    Vector(int size) : Vector(size, T{}) {}
-    Vector(int size, const T& value) {
+    Vector(std::size_t size) : Vector(size, T{}) {}
+    Vector(std::size_t size, const T& value) {
         m_size = size;
         if (size > 0) {
             m_capacity = detail::next_pow2(size);
-            m_data = new T[m_capacity];
-            for (int i{0}; i < m_capacity; i++) {
-                m_data[i] = value;
+            m_data = std::allocator<T>{}.allocate(m_capacity);
+            try {
+                std::uninitialized_fill_n(m_data, m_size, value);
+            } catch (...) {
+                std::allocator<T>{}.deallocate(m_data, m_capacity);
+                throw;
             }
         } else {
             m_capacity = 0;
@@ -35,9 +43,12 @@ public:
         m_size = other.m_size;
         m_capacity = other.m_capacity;
         if (m_capacity > 0) {
-            m_data = new T[m_capacity];
-            for (int i{0}; i < m_capacity; i++) {
-                m_data[i] = other.m_data[i];
+            m_data = std::allocator<T>{}.allocate(m_capacity);
+            try {
+                std::uninitialized_copy_n(other.m_data, m_size, m_data);
+            } catch (...) {
+                std::allocator<T>{}.deallocate(m_data, m_capacity);
+                throw;
             }
         } else {
             m_data = nullptr;
@@ -47,7 +58,8 @@ public:
         this->swap(other);
     }
     ~Vector() {
-        delete[] m_data;
+        std::destroy_n(m_data, m_size);
+        if (m_data) std::allocator<T>{}.deallocate(m_data, m_capacity);
     }
 
     // copy-and-swap here
@@ -56,7 +68,7 @@ public:
         return *this;
     }
 
-    int size() const {
+    std::size_t size() const {
         return m_size;
     }
 
@@ -64,28 +76,45 @@ public:
     // (std::forward_like not ready yet)
     template <typename Self>
     std::conditional_t<std::is_const_v<std::remove_reference_t<Self>>, const T&, T&> operator[](
-        this Self&& self, int index) {
+        this Self&& self, std::size_t index) {
         return self.m_data[index];
     }
 
     void push_back(const T& element) {
-        if (m_capacity == 0) {
-            m_size = m_capacity = 1;
-            m_data = new T[1]{element};
-        } else if (m_size == m_capacity) {
+        if (m_size == m_capacity) {
             auto newSize = m_size + 1;
             auto newCapacity = detail::next_pow2(newSize);
-            auto newData = new T[newCapacity];
-            for (size_t i = 0; i < m_size; i++) {
-                newData[i] = m_data[i];
+            auto newData = std::allocator<T>{}.allocate(newCapacity);
+            try {
+                std::construct_at(newData + m_size, element);
+            } catch (...) {
+                std::allocator<T>{}.deallocate(newData, newCapacity);
+                throw;
+            }
+            // trivially copyable elements are relocated with one memcpy
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                if (m_size > 0) std::memcpy(newData, m_data, m_size * sizeof(T));
+            } else {
+                // move only when that cannot throw, so a failure leaves *this intact
+                std::size_t moved = 0;
+                try {
+                    for (; moved < m_size; moved++) {
+                        std::construct_at(newData + moved, std::move_if_noexcept(m_data[moved]));
+                    }
+                } catch (...) {
+                    std::destroy_n(newData, moved);
+                    std::destroy_at(newData + m_size);
+                    std::allocator<T>{}.deallocate(newData, newCapacity);
+                    throw;
+                }
+                std::destroy_n(m_data, m_size);
             }
-            newData[m_size] = element;
-            delete[] m_data;
+            if (m_data) std::allocator<T>{}.deallocate(m_data, m_capacity);
             m_data = newData;
             m_capacity = newCapacity;
             m_size = newSize;
         } else {
-            m_data[m_size] = element;
+            std::construct_at(m_data + m_size, element);
             m_size++;
         }
     }
@@ -93,10 +122,9 @@ public:
     void pop_back() {
         if (m_size == 0) return;
         m_size--;
-        if (m_size == 0) {
-            delete[] m_data;
-            m_data = nullptr;
-        }
+        // keep the buffer: freeing it at size 0 made push/pop around zero
+        // reallocate every time
+        std::destroy_at(m_data + m_size);
     }
 
     void swap(Vector<T>& other) {
@@ -107,8 +135,8 @@ public:
 
 private:
     T* m_data;
-    int m_capacity;
-    int m_size;
+    std::size_t m_capacity;
+    std::size_t m_size;
 };
 
 int main() {
@@ -122,7 +150,7 @@ int main() {
     for (int i = 1; i <= 5; i++) {
         a.push_back(i);
     }
-    for (int i = 0; i < a.size(); i++) {
+    for (std::size_t i = 0; i < a.size(); i++) {
         std::cout << a[i] << std::endl;
     }
 }
\ No newline at end of file
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <type_traits>
+
+// Checked iterators are on unless NDEBUG is defined; define
+// VECTOR_CHECKED_ITERATORS to 0 or 1 to choose explicitly. When off, Vector's
+// iterator is a plain T* and the generation counter does not exist.
+#ifndef VECTOR_CHECKED_ITERATORS
+#ifdef NDEBUG
+#define VECTOR_CHECKED_ITERATORS 0
+#else
+#define VECTOR_CHECKED_ITERATORS 1
+#endif
+#endif
+
+namespace detail {
+[[noreturn]] inline void iteratorFailure(const char* message) {
+    std::fprintf(stderr, "Vector iterator: %s\n", message);
+    std::abort();
+}
+}  // namespace detail
+
+// A pointer into an Owner's buffer that remembers the owner's generation
+// when it was made. The owner bumps its generation whenever the buffer
+// moves, so a dereference after a reallocation or an assignment aborts, as
+// does one outside [data(), data() + size()), e.g. after pop_back. Owner
+// provides data(), size() and generation(). The owner itself must outlive
+// the iterator.
+template <typename T, typename Owner>
+class CheckedIterator {
+public:
+    using iterator_concept = std::contiguous_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    CheckedIterator() = default;
+    CheckedIterator(const Owner* owner, T* ptr)
+        : m_owner{owner}, m_ptr{ptr}, m_generation{owner->generation()} {}
+
+    T& operator*() const {
+        checkElement(m_ptr);
+        return *m_ptr;
+    }
+
+    // no range check: std::to_address calls this on end iterators too
+    T* operator->() const {
+        checkGeneration();
+        return m_ptr;
+    }
+
+    T& operator[](difference_type n) const {
+        checkElement(m_ptr + n);
+        return m_ptr[n];
+    }
+
+    CheckedIterator& operator++() {
+        ++m_ptr;
+        return *this;
+    }
+
+    CheckedIterator operator++(int) {
+        auto old = *this;
+        ++m_ptr;
+        return old;
+    }
+
+    CheckedIterator& operator--() {
+        --m_ptr;
+        return *this;
+    }
+
+    CheckedIterator operator--(int) {
+        auto old = *this;
+        --m_ptr;
+        return old;
+    }
+
+    CheckedIterator& operator+=(difference_type n) {
+        m_ptr += n;
+        return *this;
+    }
+
+    CheckedIterator& operator-=(difference_type n) {
+        m_ptr -= n;
+        return *this;
+    }
+
+    friend CheckedIterator operator+(CheckedIterator it, difference_type n) {
+        return it += n;
+    }
+
+    friend CheckedIterator operator+(difference_type n, CheckedIterator it) {
+        return it += n;
+    }
+
+    friend CheckedIterator operator-(CheckedIterator it, difference_type n) {
+        return it -= n;
+    }
+
+    friend difference_type operator-(const CheckedIterator& lhs, const CheckedIterator& rhs) {
+        return lhs.m_ptr - rhs.m_ptr;
+    }
+
+    friend bool operator==(const CheckedIterator& lhs, const CheckedIterator& rhs) {
+        return lhs.m_ptr == rhs.m_ptr;
+    }
+
+    friend auto operator<=>(const CheckedIterator& lhs, const CheckedIterator& rhs) {
+        return lhs.m_ptr <=> rhs.m_ptr;
+    }
+
+private:
+    void checkGeneration() const {
+        if (!m_owner) detail::iteratorFailure("singular iterator");
+        if (m_owner->generation() != m_generation) {
+            detail::iteratorFailure("the Vector reallocated or was reassigned");
+        }
+    }
+
+    void checkElement(const T* p) const {
+        checkGeneration();
+        const T* first = m_owner->data();
+        if (p < first || p >= first + m_owner->size()) {
+            detail::iteratorFailure("dereference outside the elements");
+        }
+    }
+
+    const Owner* m_owner{nullptr};
+    T* m_ptr{nullptr};
+    std::size_t m_generation{0};
+};
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "./vector.hpp"
+
+// Append-only Vector that many threads may push_back into at once without
+// a lock. Elements live in segments of 8, 16, 32, ... elements that are
+// never moved or freed while the ConcurrentVector lives, so references to
+// elements stay valid and reading an element is two plain loads.
+//
+// push_back and emplace_back return the index of the new element. Other
+// threads may read that element once they synchronize with the push (for
+// example after joining the producers, or by receiving the index through
+// an atomic or a queue). size() is the length of the prefix of elements
+// that are fully built, so readers may look at [0, size()) while producers
+// are still running; a slow push holds size() back until it finishes.
+// clear(), compact() and destruction must not overlap with other calls.
+template <typename T>
+class ConcurrentVector {
+public:
+    ConcurrentVector() = default;
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    ~ConcurrentVector() {
+        clear();
+    }
+
+    std::size_t size() const {
+        return m_size.load(std::memory_order_acquire);
+    }
+
+    const T& operator[](std::size_t index) const {
+        const auto [segment, offset] = locate(index);
+        return m_segments[segment].load(std::memory_order_acquire)[offset];
+    }
+
+    T& operator[](std::size_t index) {
+        const auto [segment, offset] = locate(index);
+        return m_segments[segment].load(std::memory_order_acquire)[offset];
+    }
+
+    std::size_t push_back(const T& element) {
+        return emplace_back(element);
+    }
+
+    std::size_t push_back(T&& element) {
+        return emplace_back(std::move(element));
+    }
+
+    // Lock-free: a thread only retries when another one claimed a slot
+    // first. The slot is claimed after its segment exists, and the element
+    // is built so that nothing can throw after the claim, so a failed push
+    // leaves no gap.
+    template <typename... Args>
+    std::size_t emplace_back(Args&&... args) {
+        if constexpr (std::is_nothrow_constructible_v<T, Args...>) {
+            const std::size_t index = claim();
+            std::construct_at(&(*this)[index], std::forward<Args>(args)...);
+            publish(index);
+            return index;
+        } else {
+            static_assert(std::is_nothrow_move_constructible_v<T>,
+                          "elements are built aside and moved into place");
+            T element(std::forward<Args>(args)...);
+            const std::size_t index = claim();
+            std::construct_at(&(*this)[index], std::move(element));
+            publish(index);
+            return index;
+        }
+    }
+
+    // destroys the elements and frees the segments
+    void clear() {
+        const std::size_t n = m_claimed.load(std::memory_order_acquire);
+        for (std::size_t k{0}; k < SEGMENTS; ++k) {
+            T* segment = m_segments[k].exchange(nullptr, std::memory_order_acq_rel);
+            if (!segment) continue;
+            const std::size_t first = segmentStart(k);
+            if (first < n) std::destroy_n(segment, std::min(segmentSize(k), n - first));
+            freeSegment(segment, k);
+        }
+        m_claimed.store(0, std::memory_order_release);
+        m_size.store(0, std::memory_order_release);
+    }
+
+    // Moves the elements, in index order, into one contiguous Vector and
+    // leaves this ConcurrentVector empty. Call once the producers are done.
+    Vector<T> compact() {
+        const std::size_t n = m_claimed.load(std::memory_order_acquire);
+        Vector<T> result;
+        result.reserve(n);
+        for (std::size_t k{0}; k < SEGMENTS && segmentStart(k) < n; ++k) {
+            T* segment = m_segments[k].load(std::memory_order_acquire);
+            const std::size_t count = std::min(segmentSize(k), n - segmentStart(k));
+            for (std::size_t i{0}; i < count; ++i) result.push_back(std::move(segment[i]));
+        }
+        clear();
+        return result;
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const ConcurrentVector& rhs) {
+        out << "[ ";
+        for (std::size_t i{0}; i < rhs.size(); ++i) {
+            out << rhs[i] << " ";
+        }
+        return out << "]";
+    }
+
+private:
+    static constexpr std::size_t FIRST_BITS{3};
+    static constexpr std::size_t SEGMENTS{sizeof(std::size_t) * 8 - FIRST_BITS};
+
+    struct Location {
+        std::size_t segment;
+        std::size_t offset;
+    };
+
+    static constexpr std::size_t segmentSize(std::size_t k) {
+        return std::size_t{1} << (k + FIRST_BITS);
+    }
+
+    // index of the first element of segment k
+    static constexpr std::size_t segmentStart(std::size_t k) {
+        return segmentSize(k) - segmentSize(0);
+    }
+
+    static constexpr Location locate(std::size_t index) {
+        const std::size_t j = index + segmentSize(0);
+        const std::size_t k = std::bit_width(j) - 1 - FIRST_BITS;
+        return {k, j - segmentSize(k)};
+    }
+
+    // A segment is one block: the elements, then one "built" flag per
+    // element, all false in a fresh segment.
+    static T* allocateSegment(std::size_t k) {
+        const std::size_t n = segmentSize(k);
+        void* block = ::operator new(n * (sizeof(T) + sizeof(std::atomic<bool>)),
+                                     std::align_val_t{alignof(T)});
+        T* segment = static_cast<T*>(block);
+        for (std::size_t i{0}; i < n; ++i) std::construct_at(flags(segment, k) + i, false);
+        return segment;
+    }
+
+    static void freeSegment(T* segment, std::size_t k) {
+        ::operator delete(segment, segmentSize(k) * (sizeof(T) + sizeof(std::atomic<bool>)),
+                          std::align_val_t{alignof(T)});
+    }
+
+    static std::atomic<bool>* flags(T* segment, std::size_t k) {
+        return reinterpret_cast<std::atomic<bool>*>(segment + segmentSize(k));
+    }
+
+    std::atomic<bool>& built(std::size_t index) const {
+        const auto [segment, offset] = locate(index);
+        return flags(m_segments[segment].load(std::memory_order_acquire), segment)[offset];
+    }
+
+    // makes sure segment k exists; racing threads may allocate it twice,
+    // and the losers free their copy
+    void ensureSegment(std::size_t k) {
+        if (m_segments[k].load(std::memory_order_acquire)) return;
+        T* fresh = allocateSegment(k);
+        T* expected = nullptr;
+        if (!m_segments[k].compare_exchange_strong(expected, fresh, std::memory_order_acq_rel)) {
+            freeSegment(fresh, k);
+        }
+    }
+
+    // the slot's segment exists before the slot can be claimed, and the
+    // release makes it visible to whoever sees the claim
+    std::size_t claim() {
+        std::size_t index = m_claimed.load(std::memory_order_relaxed);
+        for (;;) {
+            ensureSegment(locate(index).segment);
+            if (m_claimed.compare_exchange_weak(index, index + 1, std::memory_order_release,
+                                                std::memory_order_relaxed)) {
+                return index;
+            }
+        }
+    }
+
+    // Marks element index built and moves size() past every built element
+    // after it. Whichever push finishes the oldest pending element carries
+    // size() forward; the flag and size() accesses are sequentially
+    // consistent so that of two pushes finishing at once, at least one sees
+    // the other's flag and none is left behind.
+    void publish(std::size_t index) {
+        built(index).store(true);
+        std::size_t n = m_size.load();
+        while (n < m_claimed.load(std::memory_order_acquire) && built(n).load()) {
+            if (m_size.compare_exchange_weak(n, n + 1)) ++n;
+        }
+    }
+
+    std::atomic<T*> m_segments[SEGMENTS]{};
+    std::atomic<std::size_t> m_claimed{0};
+    // the elements [0, m_size) are all built
+    std::atomic<std::size_t> m_size{0};
+};
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <utility>
+
+#include "./vector.hpp"
+
+// Vector whose copies share one buffer until one of them is modified
+// ("copy on write"). Copying and assigning only bump a reference count, so
+// handing a large Vector to many readers costs nothing; the first call
+// through a non-const member (operator[], begin(), push_back, edit(), ...)
+// of a shared CowVector copies the elements into a buffer of its own.
+//
+// Reading through a non-const CowVector still counts as writing, so
+// readers should hold it by const reference or use the const members, e.g.
+// std::as_const(v)[i]. Once a CowVector has handed out a mutable reference
+// or iterator (operator[], begin(), end(), emplace_back(), edit()), its
+// buffer is "leaked": copies of it are deep from then on, so writes
+// through that reference never reach a copy. Assigning to it or clearing
+// it makes it shareable again. Distinct CowVectors may be used from
+// different threads even while they share a buffer.
+template <typename T, typename Alloc = std::allocator<T>, typename Growth = growth::Double>
+class CowVector {
+public:
+    using Base = Vector<T, Alloc, Growth>;
+    using value_type = T;
+    using iterator = typename Base::iterator;
+    using const_iterator = const T*;
+
+    CowVector() = default;
+
+    explicit CowVector(std::size_t size) : m_data{std::make_shared<Base>(size)} {}
+
+    CowVector(std::size_t size, const T& value) : m_data{std::make_shared<Base>(size, value)} {}
+
+    // takes over vector's elements without copying them
+    CowVector(Base vector) : m_data{std::make_shared<Base>(std::move(vector))} {}
+
+    CowVector(const CowVector& other)
+        : m_data{other.m_leaked ? std::make_shared<Base>(*other.m_data) : other.m_data} {}
+
+    CowVector(CowVector&& other) noexcept
+        : m_data{std::move(other.m_data)}, m_leaked{std::exchange(other.m_leaked, false)} {}
+
+    CowVector& operator=(CowVector other) noexcept {
+        m_data = std::move(other.m_data);
+        m_leaked = other.m_leaked;
+        return *this;
+    }
+
+    std::size_t size() const {
+        return m_data ? m_data->size() : 0;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    std::size_t capacity() const {
+        return m_data ? m_data->capacity() : 0;
+    }
+
+    // whether another CowVector shares the buffer
+    bool isShared() const {
+        return m_data && m_data.use_count() > 1;
+    }
+
+    const T* data() const {
+        return m_data ? m_data->data() : nullptr;
+    }
+
+    const T& operator[](std::size_t index) const {
+        return (*m_data)[index];
+    }
+
+    T& operator[](std::size_t index) {
+        return edit()[index];
+    }
+
+    const_iterator begin() const {
+        return data();
+    }
+
+    const_iterator end() const {
+        return data() + size();
+    }
+
+    iterator begin() {
+        return edit().begin();
+    }
+
+    iterator end() {
+        return edit().end();
+    }
+
+    // the elements, read-only and without copying
+    const Base& view() const {
+        static const Base empty;
+        return m_data ? *m_data : empty;
+    }
+
+    // the elements for modification, first copied if they are shared; the
+    // buffer is leaked from then on
+    Base& edit() {
+        Base& elements = unshare();
+        m_leaked = true;
+        return elements;
+    }
+
+    void reserve(std::size_t capacity) {
+        unshare().reserve(capacity);
+    }
+
+    void resize(std::size_t size) {
+        unshare().resize(size);
+    }
+
+    // drops this CowVector's share without copying anything
+    void clear() {
+        if (isShared()) {
+            m_data.reset();
+        } else if (m_data) {
+            m_data->clear();
+        }
+        m_leaked = false;
+    }
+
+    void push_back(const T& element) {
+        unshare().push_back(element);
+    }
+
+    void push_back(T&& element) {
+        unshare().push_back(std::move(element));
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        return edit().emplace_back(std::forward<Args>(args)...);
+    }
+
+    void pop_back() {
+        if (size() > 0) unshare().pop_back();
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const CowVector& rhs) {
+        return out << rhs.view();
+    }
+
+private:
+    // the elements, first copied if they are shared, without leaking them
+    Base& unshare() {
+        if (!m_data) {
+            m_data = std::make_shared<Base>();
+        } else if (m_data.use_count() > 1) {
+            m_data = std::make_shared<Base>(*m_data);
+        } else {
+            // pairs with the release by which other owners gave up the
+            // buffer, so their reads happen before our writes
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *m_data;
+    }
+
+    // null until the first element is added
+    std::shared_ptr<Base> m_data;
+    // a mutable reference into m_data may exist, so it must not be shared
+    bool m_leaked{false};
+};
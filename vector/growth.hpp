@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Growth policies for Vector. A policy has two static functions:
+//     std::size_t grow(std::size_t capacity, std::size_t required, std::size_t elementSize)
+// returns the new capacity when the buffer is full and required elements
+// must fit, and
+//     std::size_t shrink(std::size_t capacity, std::size_t size)
+// returns the capacity to shrink to after a pop_back, or capacity to keep it.
+// Vector clamps whatever grow returns to [required, max_size()], so a policy
+// may saturate instead of checking for overflow itself.
+namespace growth {
+struct Double {
+    static std::size_t grow(std::size_t capacity, std::size_t required, std::size_t) {
+        const std::size_t next = capacity > SIZE_MAX / 2 ? SIZE_MAX : capacity * 2;
+        return next > required ? next : required;
+    }
+
+    static std::size_t shrink(std::size_t capacity, std::size_t) {
+        return capacity;
+    }
+};
+
+// wastes less memory than Double, and a freed block can eventually be
+// reused by a later growth of the same Vector
+struct OneAndHalf {
+    static std::size_t grow(std::size_t capacity, std::size_t required, std::size_t) {
+        const std::size_t next =
+            capacity > SIZE_MAX / 3 * 2 ? SIZE_MAX : capacity + capacity / 2;
+        return next > required ? next : required;
+    }
+
+    static std::size_t shrink(std::size_t capacity, std::size_t) {
+        return capacity;
+    }
+};
+
+// doubles, then fills the last page of the buffer, so large Vectors never
+// leave a partial page unused
+template <std::size_t PageSize = 4096>
+struct PageRounded {
+    static std::size_t grow(std::size_t capacity, std::size_t required, std::size_t elementSize) {
+        const std::size_t wanted = Double::grow(capacity, required, elementSize);
+        if (wanted > (SIZE_MAX - PageSize) / elementSize) return wanted;
+        const std::size_t bytes = (wanted * elementSize + PageSize - 1) / PageSize * PageSize;
+        return bytes / elementSize;
+    }
+
+    static std::size_t shrink(std::size_t capacity, std::size_t) {
+        return capacity;
+    }
+};
+
+// Grows like Base and halves the capacity once the size drops to a quarter
+// of it, but never below MinCapacity. The gap between the two thresholds
+// means a push/pop pattern at any size reallocates at most once.
+template <typename Base = Double, std::size_t MinCapacity = 16>
+struct Hysteresis : Base {
+    static std::size_t shrink(std::size_t capacity, std::size_t size) {
+        return capacity > MinCapacity && size <= capacity / 4 ? capacity / 2 : capacity;
+    }
+};
+}  // namespace growth
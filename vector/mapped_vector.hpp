@@ -0,0 +1,348 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "./vector.hpp"
+
+enum class HugePages {
+    None,
+    // let the kernel back the buffer with huge pages when it can (MADV_HUGEPAGE)
+    Transparent,
+    // take huge pages from the reserved pool (MAP_HUGETLB / MEM_LARGE_PAGES),
+    // falling back to Transparent when none are available
+    Explicit,
+};
+
+namespace detail {
+inline constexpr std::size_t HUGE_PAGE_SIZE{std::size_t{2} << 20};
+
+inline std::size_t pageSize() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#else
+    static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+#endif
+}
+
+// fresh zero-filled read-write pages; bytes is a multiple of the page size
+inline void* mapPages(std::size_t bytes, HugePages huge) {
+#ifdef _WIN32
+    void* p = nullptr;
+    if (huge == HugePages::Explicit) {
+        // needs SeLockMemoryPrivilege, so this fails for most processes
+        p = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+                         PAGE_READWRITE);
+    }
+    if (!p) p = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (!p) throw std::bad_alloc();
+    return p;
+#else
+    constexpr int PROT = PROT_READ | PROT_WRITE;
+    constexpr int FLAGS = MAP_PRIVATE | MAP_ANONYMOUS;
+    void* p = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (huge == HugePages::Explicit) p = ::mmap(nullptr, bytes, PROT, FLAGS | MAP_HUGETLB, -1, 0);
+#endif
+    if (p == MAP_FAILED) p = ::mmap(nullptr, bytes, PROT, FLAGS, -1, 0);
+    if (p == MAP_FAILED) throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+    if (huge != HugePages::None) ::madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+    return p;
+#endif
+}
+
+inline void unmapPages(void* p, std::size_t bytes) {
+#ifdef _WIN32
+    (void)bytes;
+    VirtualFree(p, 0, MEM_RELEASE);
+#else
+    ::munmap(p, bytes);
+#endif
+}
+
+// Enlarges a mapping to new_bytes. On Linux mremap moves the page tables,
+// so nothing is copied even when the address changes; elsewhere the first
+// used bytes are copied into a new mapping.
+inline void* growPages(void* p, std::size_t bytes, std::size_t used, std::size_t new_bytes,
+                       HugePages huge) {
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+    void* q = ::mremap(p, bytes, new_bytes, MREMAP_MAYMOVE);
+    if (q != MAP_FAILED) return q;
+#endif
+    // also reached for hugetlb mappings on kernels that cannot remap them
+    void* fresh = mapPages(new_bytes, huge);
+    std::memcpy(fresh, p, used);
+    unmapPages(p, bytes);
+    return fresh;
+}
+
+// Cuts a mapping down to new_bytes (a multiple of the page size, possibly 0).
+inline void* shrinkPages(void* p, std::size_t bytes, std::size_t used, std::size_t new_bytes,
+                         HugePages huge) {
+    if (new_bytes == 0) {
+        unmapPages(p, bytes);
+        return nullptr;
+    }
+#ifdef _WIN32
+    // a reservation cannot be split, so move to a smaller one
+    void* fresh = mapPages(new_bytes, huge);
+    std::memcpy(fresh, p, used);
+    unmapPages(p, bytes);
+    return fresh;
+#else
+    (void)used;
+    (void)huge;
+    ::munmap(static_cast<char*>(p) + new_bytes, bytes - new_bytes);
+    return p;
+#endif
+}
+
+// returns the memory behind whole pages to the system but keeps the address range
+inline void discardPages(void* p, std::size_t bytes) {
+#ifdef _WIN32
+    VirtualAlloc(p, bytes, MEM_RESET, PAGE_READWRITE);
+#else
+    ::madvise(p, bytes, MADV_DONTNEED);
+#endif
+}
+}  // namespace detail
+
+// Vector whose buffer is an anonymous memory mapping instead of a heap
+// block. Growing remaps the pages rather than copying the elements, which
+// keeps push_back pauses flat for buffers of many gigabytes; the capacity
+// always fills whole pages (2 MiB ones when huge pages are requested).
+// Elements must be trivially relocatable, since the kernel moves their bytes.
+// clear() and shrinking resize() hand the pages past the last element back
+// with madvise, keeping the address range for later growth; shrink_to_fit()
+// unmaps them. Copying a whole mapping is rarely intended, so MappedVector
+// is move-only.
+template <typename T>
+struct MappedVector {
+    static_assert(isTriviallyRelocatable<T>, "elements are moved bytewise with the pages");
+
+public:
+    explicit MappedVector(HugePages huge = HugePages::None);
+    MappedVector(const MappedVector&) = delete;
+    MappedVector(MappedVector&& other) noexcept;
+    ~MappedVector();
+    MappedVector& operator=(const MappedVector&) = delete;
+    MappedVector& operator=(MappedVector&& other) noexcept;
+    const T& operator[](std::size_t index) const;
+    T& operator[](std::size_t index);
+    std::size_t size() const;
+    std::size_t capacity() const;
+    void reserve(std::size_t capacity);
+    void resize(std::size_t size);
+    void shrink_to_fit();
+    void clear();
+    void push_back(const T& element);
+    void push_back(T&& element);
+    template <typename... Args>
+    T& emplace_back(Args&&... args);
+    void pop_back();
+
+    using iterator = T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    iterator begin() const {
+        return m_data;
+    }
+
+    iterator end() const {
+        return m_data + m_size;
+    }
+
+    reverse_iterator rbegin() const {
+        return reverse_iterator(m_data + m_size);
+    }
+
+    reverse_iterator rend() const {
+        return reverse_iterator(m_data);
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const MappedVector& rhs) {
+        out << "[ ";
+        for (const auto& i : rhs) {
+            out << i << " ";
+        }
+        return out << "]";
+    }
+
+private:
+    T* m_data;
+    std::size_t m_bytes;
+    std::size_t m_size;
+    HugePages m_huge;
+
+    std::size_t roundToPages(std::size_t bytes) const {
+        const std::size_t granule =
+            m_huge == HugePages::None ? detail::pageSize() : detail::HUGE_PAGE_SIZE;
+        return (bytes + granule - 1) / granule * granule;
+    }
+
+    // makes room for required elements, at least doubling the mapping
+    void grow(std::size_t required);
+
+    void releaseTail() {
+        const std::size_t used = roundToPages(m_size * sizeof(T));
+        if (used < m_bytes) {
+            detail::discardPages(reinterpret_cast<char*>(m_data) + used, m_bytes - used);
+        }
+    }
+};
+
+template <typename T>
+MappedVector<T>::MappedVector(HugePages huge) {
+    m_data = nullptr;
+    m_bytes = 0;
+    m_size = 0;
+    m_huge = huge;
+}
+
+template <typename T>
+MappedVector<T>::MappedVector(MappedVector&& other) noexcept
+    : m_data{other.m_data}, m_bytes{other.m_bytes}, m_size{other.m_size}, m_huge{other.m_huge} {
+    other.m_data = nullptr;
+    other.m_bytes = 0;
+    other.m_size = 0;
+}
+
+template <typename T>
+MappedVector<T>::~MappedVector() {
+    std::destroy_n(m_data, m_size);
+    if (m_data) detail::unmapPages(m_data, m_bytes);
+}
+
+template <typename T>
+MappedVector<T>& MappedVector<T>::operator=(MappedVector&& other) noexcept {
+    if (this != &other) {
+        std::destroy_n(m_data, m_size);
+        if (m_data) detail::unmapPages(m_data, m_bytes);
+        m_data = std::exchange(other.m_data, nullptr);
+        m_bytes = std::exchange(other.m_bytes, 0);
+        m_size = std::exchange(other.m_size, 0);
+        m_huge = other.m_huge;
+    }
+    return *this;
+}
+
+template <typename T>
+const T& MappedVector<T>::operator[](std::size_t index) const {
+    return m_data[index];
+}
+
+template <typename T>
+T& MappedVector<T>::operator[](std::size_t index) {
+    return m_data[index];
+}
+
+template <typename T>
+std::size_t MappedVector<T>::size() const {
+    return m_size;
+}
+
+template <typename T>
+std::size_t MappedVector<T>::capacity() const {
+    return m_bytes / sizeof(T);
+}
+
+template <typename T>
+void MappedVector<T>::grow(std::size_t required) {
+    const std::size_t limit = (PTRDIFF_MAX - detail::HUGE_PAGE_SIZE) / sizeof(T);
+    if (required > limit) throw std::length_error("MappedVector too large");
+    std::size_t bytes = required * sizeof(T);
+    if (bytes < m_bytes * 2) bytes = m_bytes * 2;
+    bytes = roundToPages(bytes);
+    if (m_data) {
+        m_data = static_cast<T*>(
+            detail::growPages(m_data, m_bytes, m_size * sizeof(T), bytes, m_huge));
+    } else {
+        m_data = static_cast<T*>(detail::mapPages(bytes, m_huge));
+    }
+    m_bytes = bytes;
+}
+
+template <typename T>
+void MappedVector<T>::reserve(std::size_t capacity) {
+    if (capacity > this->capacity()) grow(capacity);
+}
+
+template <typename T>
+void MappedVector<T>::resize(std::size_t size) {
+    if (size <= m_size) {
+        std::destroy(m_data + size, m_data + m_size);
+        m_size = size;
+        releaseTail();
+        return;
+    }
+    if (size > capacity()) grow(size);
+    for (; m_size < size; m_size++) {
+        std::construct_at(m_data + m_size);
+    }
+}
+
+template <typename T>
+void MappedVector<T>::shrink_to_fit() {
+    const std::size_t bytes = roundToPages(m_size * sizeof(T));
+    if (bytes < m_bytes) {
+        m_data = static_cast<T*>(
+            detail::shrinkPages(m_data, m_bytes, m_size * sizeof(T), bytes, m_huge));
+        m_bytes = bytes;
+    }
+}
+
+template <typename T>
+void MappedVector<T>::clear() {
+    resize(0);
+}
+
+template <typename T>
+void MappedVector<T>::push_back(const T& element) {
+    emplace_back(element);
+}
+
+template <typename T>
+void MappedVector<T>::push_back(T&& element) {
+    emplace_back(std::move(element));
+}
+
+template <typename T>
+template <typename... Args>
+T& MappedVector<T>::emplace_back(Args&&... args) {
+    if (m_size < capacity()) {
+        std::construct_at(m_data + m_size, std::forward<Args>(args)...);
+    } else {
+        // args may refer into the mapping, which grow() can move
+        T element(std::forward<Args>(args)...);
+        grow(m_size + 1);
+        std::construct_at(m_data + m_size, std::move(element));
+    }
+    return m_data[m_size++];
+}
+
+template <typename T>
+void MappedVector<T>::pop_back() {
+    if (m_size > 0) std::destroy_at(m_data + --m_size);
+}
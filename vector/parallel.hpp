@@ -0,0 +1,445 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// A fixed set of worker threads, each with its own task deque. A worker
+// takes its newest task first and, when its deque is empty, steals the
+// oldest task of another worker. A thread waiting in run() executes queued
+// tasks itself instead of blocking, so parallel algorithms may nest.
+class ThreadPool {
+public:
+    // threads == 0 means one per core this process may run on. With pin,
+    // worker i is bound to the i-th of those cores (modulo their number);
+    // pinning suits a single pool owning the machine, as two pinned pools
+    // share the same cores.
+    explicit ThreadPool(std::size_t threads = 0, bool pin = false) {
+        const std::vector<std::size_t> cores = allowedCores();
+        if (threads == 0) threads = cores.size();
+        for (std::size_t i{0}; i < threads; ++i) {
+            m_queues.push_back(std::make_unique<Queue>());
+        }
+        try {
+            for (std::size_t i{0}; i < threads; ++i) {
+                m_threads.emplace_back([this, i] { work(i); });
+                if (pin) pinToCore(m_threads.back(), cores[i % cores.size()]);
+            }
+        } catch (...) {
+            // the workers already started would terminate the program when destroyed
+            stop();
+            throw;
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        stop();
+    }
+
+    std::size_t size() const {
+        return m_threads.size();
+    }
+
+    // the pool the parallel algorithms use unless told otherwise
+    static ThreadPool& shared() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    // Calls f(i) for every i in [0, tasks) on the pool and the calling
+    // thread, and returns once all calls have finished. The first exception
+    // thrown by a call is rethrown here. If queueing a task fails, the
+    // tasks already queued still run to completion before the failure is
+    // rethrown, since they refer to this call's frame.
+    template <typename F>
+    void run(std::size_t tasks, F&& f) {
+        std::atomic<std::size_t> remaining{tasks};
+        std::exception_ptr error;
+        std::mutex errorMutex;
+        std::size_t queued{0};
+        try {
+            for (; queued < tasks; ++queued) {
+                push([&, i = queued] {
+                    try {
+                        f(i);
+                    } catch (...) {
+                        std::lock_guard lock{errorMutex};
+                        if (!error) error = std::current_exception();
+                    }
+                    remaining.fetch_sub(1, std::memory_order_release);
+                });
+            }
+        } catch (...) {
+            remaining.fetch_sub(tasks - queued, std::memory_order_relaxed);
+            waitFor(remaining);
+            throw;
+        }
+        waitFor(remaining);
+        if (error) std::rethrow_exception(error);
+    }
+
+private:
+    using Task = std::function<void()>;
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    static constexpr std::size_t NOT_A_WORKER = static_cast<std::size_t>(-1);
+    static inline thread_local const ThreadPool* t_pool = nullptr;
+    static inline thread_local std::size_t t_index = NOT_A_WORKER;
+
+    // the cores in the process's affinity mask, e.g. as limited by taskset
+    // or a cgroup; all hardware threads where the mask cannot be read
+    static std::vector<std::size_t> allowedCores() {
+        std::vector<std::size_t> cores;
+#ifdef _WIN32
+        DWORD_PTR process, system;
+        if (GetProcessAffinityMask(GetCurrentProcess(), &process, &system)) {
+            for (std::size_t core{0}; core < 64; ++core) {
+                if (process >> core & 1) cores.push_back(core);
+            }
+        }
+#elif defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof set, &set) == 0) {
+            for (std::size_t core{0}; core < CPU_SETSIZE; ++core) {
+                if (CPU_ISSET(core, &set)) cores.push_back(core);
+            }
+        }
+#endif
+        if (cores.empty()) {
+            for (std::size_t core{0}; core < std::max(1u, std::thread::hardware_concurrency());
+                 ++core) {
+                cores.push_back(core);
+            }
+        }
+        return cores;
+    }
+
+    static void pinToCore([[maybe_unused]] std::thread& thread, [[maybe_unused]] std::size_t core) {
+#ifdef _WIN32
+        if (core < 64) SetThreadAffinityMask(thread.native_handle(), DWORD_PTR{1} << core);
+#elif defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(core, &set);
+        pthread_setaffinity_np(thread.native_handle(), sizeof set, &set);
+#endif
+    }
+
+    void stop() {
+        {
+            std::lock_guard lock{m_sleepMutex};
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (auto& thread : m_threads) thread.join();
+    }
+
+    // runs queued tasks until remaining drops to zero
+    void waitFor(const std::atomic<std::size_t>& remaining) {
+        const std::size_t self = t_pool == this ? t_index : NOT_A_WORKER;
+        while (remaining.load(std::memory_order_acquire) != 0) {
+            if (!runOne(self)) std::this_thread::yield();
+        }
+    }
+
+    void push(Task task) {
+        const std::size_t i = m_next.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+        {
+            std::lock_guard lock{m_queues[i]->mutex};
+            m_queues[i]->tasks.push_back(std::move(task));
+        }
+        m_pending.fetch_add(1, std::memory_order_release);
+        // taking the lock orders this with a worker between its check and its wait
+        { std::lock_guard lock{m_sleepMutex}; }
+        m_wake.notify_one();
+    }
+
+    // runs one queued task, preferring self's own deque; false if there was none
+    bool runOne(std::size_t self) {
+        Task task;
+        if (self != NOT_A_WORKER) {
+            Queue& own = *m_queues[self];
+            std::lock_guard lock{own.mutex};
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+            }
+        }
+        for (std::size_t k{1}; !task && k <= m_queues.size(); ++k) {
+            Queue& victim = *m_queues[(self + k) % m_queues.size()];
+            std::lock_guard lock{victim.mutex};
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+            }
+        }
+        if (!task) return false;
+        m_pending.fetch_sub(1, std::memory_order_relaxed);
+        task();
+        return true;
+    }
+
+    void work(std::size_t index) {
+        t_pool = this;
+        t_index = index;
+        for (;;) {
+            if (runOne(index)) continue;
+            std::unique_lock lock{m_sleepMutex};
+            m_wake.wait(lock, [this] {
+                return m_stop || m_pending.load(std::memory_order_acquire) > 0;
+            });
+            if (m_stop) return;
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_threads;
+    std::atomic<std::size_t> m_next{0};
+    std::atomic<std::size_t> m_pending{0};
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    bool m_stop{false};
+};
+
+// How the parallel algorithms split their input. Each task handles grain
+// consecutive elements; with grain == 0 the input is cut into about
+// tasksPerThread tasks per pool thread, but no task gets fewer than
+// minGrain elements. More tasks balance uneven work better, fewer tasks
+// cost less scheduling.
+struct ParallelOptions {
+    ThreadPool* pool{nullptr};  // nullptr is ThreadPool::shared()
+    std::size_t grain{0};
+    std::size_t tasksPerThread{4};
+    std::size_t minGrain{1 << 12};
+};
+
+namespace detail {
+struct Chunks {
+    ThreadPool& pool;
+    std::size_t n;
+    std::size_t grain;
+    std::size_t count;
+
+    std::size_t begin(std::size_t chunk) const {
+        return chunk * grain;
+    }
+
+    std::size_t end(std::size_t chunk) const {
+        return std::min(n, (chunk + 1) * grain);
+    }
+};
+
+inline Chunks makeChunks(std::size_t n, const ParallelOptions& options) {
+    ThreadPool& pool = options.pool ? *options.pool : ThreadPool::shared();
+    std::size_t grain = options.grain;
+    if (grain == 0) {
+        const std::size_t tasks = (pool.size() + 1) * std::max<std::size_t>(1, options.tasksPerThread);
+        grain = std::max(options.minGrain, (n + tasks - 1) / tasks);
+    }
+    grain = std::max<std::size_t>(1, grain);
+    return {pool, n, grain, (n + grain - 1) / grain};
+}
+
+// f(begin, end, chunk) for every chunk of [0, n), in parallel
+template <typename F>
+Chunks forEachChunk(std::size_t n, const ParallelOptions& options, F&& f) {
+    const Chunks chunks = makeChunks(n, options);
+    if (chunks.count == 1) {
+        f(std::size_t{0}, n, std::size_t{0});
+    } else if (chunks.count > 1) {
+        chunks.pool.run(chunks.count, [&](std::size_t c) { f(chunks.begin(c), chunks.end(c), c); });
+    }
+    return chunks;
+}
+}  // namespace detail
+
+// f(element) for every element
+template <std::ranges::contiguous_range R, typename F>
+void parallel_for_each(R&& range, F f, const ParallelOptions& options = {}) {
+    auto* data = std::ranges::data(range);
+    detail::forEachChunk(std::ranges::size(range), options,
+                         [&](std::size_t first, std::size_t last, std::size_t) {
+                             for (std::size_t i = first; i < last; ++i) f(data[i]);
+                         });
+}
+
+// out[i] = f(in[i]); out needs at least as many elements as in, and may be in
+template <std::ranges::contiguous_range In, std::ranges::contiguous_range Out, typename F>
+void parallel_transform(const In& in, Out&& out, F f, const ParallelOptions& options = {}) {
+    const std::size_t n = std::ranges::size(in);
+    if (std::ranges::size(out) < n) throw std::invalid_argument("Output range too small");
+    const auto* src = std::ranges::data(in);
+    auto* dst = std::ranges::data(out);
+    detail::forEachChunk(n, options, [&](std::size_t first, std::size_t last, std::size_t) {
+        for (std::size_t i = first; i < last; ++i) dst[i] = f(src[i]);
+    });
+}
+
+// Folds the elements into init with op, which must be associative. Each
+// chunk is folded on its own and the chunk results are combined in order,
+// so for a given grain the result does not depend on scheduling.
+template <std::ranges::contiguous_range R, typename T, typename Op = std::plus<>>
+T parallel_reduce(const R& range, T init, Op op = {}, const ParallelOptions& options = {}) {
+    const std::size_t n = std::ranges::size(range);
+    if (n == 0) return init;
+    const auto* data = std::ranges::data(range);
+    const detail::Chunks chunks = detail::makeChunks(n, options);
+    std::vector<T> partial(chunks.count, init);
+    detail::forEachChunk(n, options, [&](std::size_t first, std::size_t last, std::size_t c) {
+        T acc = data[first];
+        for (std::size_t i = first + 1; i < last; ++i) acc = op(std::move(acc), data[i]);
+        partial[c] = std::move(acc);
+    });
+    for (auto& value : partial) init = op(std::move(init), std::move(value));
+    return init;
+}
+
+namespace detail {
+// How many of the first out elements of merging a[0, na) and b[0, nb)
+// come from a, ties going to a. Binary search on the "merge path".
+template <typename T, typename Compare>
+std::size_t coRank(std::size_t out, const T* a, std::size_t na, const T* b, std::size_t nb,
+                   Compare& comp) {
+    std::size_t lo = out > nb ? out - nb : 0;
+    std::size_t hi = std::min(out, na);
+    while (lo < hi) {
+        const std::size_t i = lo + (hi - lo) / 2;
+        const std::size_t j = out - i;
+        if (i == na || j == 0 || comp(b[j - 1], a[i])) {
+            hi = i;
+        } else {
+            lo = i + 1;
+        }
+    }
+    return lo;
+}
+}  // namespace detail
+
+// Sorts each chunk in parallel, then merges neighbouring runs in rounds.
+// Every round merges into a second buffer and is cut into chunk-sized
+// pieces of output, each found by binary search and merged on the pool, so
+// the last rounds are as parallel as the first. Element types that cannot
+// be default-constructed for the buffer merge in place instead, one
+// parallel task per pair of runs. Not stable.
+template <std::ranges::contiguous_range R, typename Compare = std::ranges::less>
+void parallel_sort(R&& range, Compare comp = {}, const ParallelOptions& options = {}) {
+    using T = std::ranges::range_value_t<R>;
+    const std::size_t n = std::ranges::size(range);
+    auto* data = std::ranges::data(range);
+    const detail::Chunks chunks =
+        detail::forEachChunk(n, options, [&](std::size_t first, std::size_t last, std::size_t) {
+            std::sort(data + first, data + last, comp);
+        });
+    if (chunks.count <= 1) return;
+    if constexpr (std::is_default_constructible_v<T>) {
+        const auto buffer = std::make_unique_for_overwrite<T[]>(n);
+        T* src = data;
+        T* dst = buffer.get();
+        // splits[c]: how many elements of its first run precede the output of piece c
+        std::vector<std::size_t> splits(chunks.count);
+        for (std::size_t width = chunks.grain; width < n; width *= 2) {
+            // a piece never straddles two merges, as 2 * width is a multiple
+            // of the grain; the searches all finish before any element is
+            // moved, as they look at elements of neighbouring pieces
+            const auto runs = [&](std::size_t piece) {
+                const std::size_t first = chunks.begin(piece) / (2 * width) * (2 * width);
+                return std::array{first, std::min(n, first + width), std::min(n, first + 2 * width)};
+            };
+            chunks.pool.run(chunks.count, [&](std::size_t piece) {
+                const auto [first, mid, last] = runs(piece);
+                splits[piece] = detail::coRank(chunks.begin(piece) - first, src + first, mid - first,
+                                               src + mid, last - mid, comp);
+            });
+            chunks.pool.run(chunks.count, [&](std::size_t piece) {
+                const auto [first, mid, last] = runs(piece);
+                const std::size_t from = chunks.begin(piece) - first;
+                const std::size_t to = chunks.end(piece) - first;
+                const std::size_t i0 = splits[piece];
+                const std::size_t i1 = to == last - first ? mid - first : splits[piece + 1];
+                std::merge(std::make_move_iterator(src + first + i0),
+                           std::make_move_iterator(src + first + i1),
+                           std::make_move_iterator(src + mid + (from - i0)),
+                           std::make_move_iterator(src + mid + (to - i1)), dst + first + from, comp);
+            });
+            std::swap(src, dst);
+        }
+        if (src != data) {
+            chunks.pool.run(chunks.count, [&](std::size_t c) {
+                std::move(src + chunks.begin(c), src + chunks.end(c), data + chunks.begin(c));
+            });
+        }
+        return;
+    }
+    for (std::size_t width = chunks.grain; width < n; width *= 2) {
+        const std::size_t merges = (n + 2 * width - 1) / (2 * width);
+        chunks.pool.run(merges, [&](std::size_t m) {
+            const std::size_t first = m * 2 * width;
+            const std::size_t mid = std::min(n, first + width);
+            const std::size_t last = std::min(n, first + 2 * width);
+            std::inplace_merge(data + first, data + mid, data + last, comp);
+        });
+    }
+}
+
+// out[i] = in[0] op in[1] op ... op in[i]; op must be associative. out
+// needs at least as many elements as in, and may be in. Two parallel
+// passes: chunk totals first, then each chunk's scan from the running
+// total of the chunks before it.
+template <std::ranges::contiguous_range In, std::ranges::contiguous_range Out,
+          typename Op = std::plus<>>
+void parallel_inclusive_scan(const In& in, Out&& out, Op op = {},
+                             const ParallelOptions& options = {}) {
+    using T = std::ranges::range_value_t<Out>;
+    const std::size_t n = std::ranges::size(in);
+    if (std::ranges::size(out) < n) throw std::invalid_argument("Output range too small");
+    if (n == 0) return;
+    const auto* src = std::ranges::data(in);
+    auto* dst = std::ranges::data(out);
+    const detail::Chunks chunks = detail::makeChunks(n, options);
+    std::vector<T> totals(chunks.count);
+    detail::forEachChunk(n, options, [&](std::size_t first, std::size_t last, std::size_t c) {
+        T acc = src[first];
+        for (std::size_t i = first + 1; i < last; ++i) acc = op(std::move(acc), src[i]);
+        totals[c] = std::move(acc);
+    });
+    // totals[c] becomes the total of chunks [0, c]
+    for (std::size_t c{1}; c < chunks.count; ++c) totals[c] = op(totals[c - 1], totals[c]);
+    detail::forEachChunk(n, options, [&](std::size_t first, std::size_t last, std::size_t c) {
+        T acc = c == 0 ? T(src[first]) : op(totals[c - 1], src[first]);
+        dst[first] = acc;
+        for (std::size_t i = first + 1; i < last; ++i) {
+            acc = op(std::move(acc), src[i]);
+            dst[i] = acc;
+        }
+    });
+}
@@ -0,0 +1,286 @@
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "./vector.hpp"
+
+// Vector with room for N elements inside the object itself. The heap is
+// only touched once the size grows past N; from then on it behaves like
+// Vector, doubling its capacity. Pointers and iterators into the inline
+// buffer do not survive moving the SmallVector.
+template <typename T, std::size_t N = 8>
+struct SmallVector {
+    static_assert(N > 0);
+
+public:
+    SmallVector();
+    SmallVector(std::size_t size);
+    SmallVector(std::size_t size, const T& value);
+    SmallVector(const SmallVector& other);
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+    ~SmallVector();
+    SmallVector& operator=(const SmallVector& other);
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+    const T& operator[](std::size_t index) const;
+    T& operator[](std::size_t index);
+    std::size_t size() const;
+    std::size_t capacity() const;
+    bool isInline() const;
+    void push_back(const T& element);
+    void push_back(T&& element);
+    template <typename... Args>
+    T& emplace_back(Args&&... args);
+    void pop_back();
+
+    using iterator = T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    struct safe_skip_iterator {
+        const SmallVector& target;
+        std::ptrdiff_t count{0};
+
+        friend bool operator==(const safe_skip_iterator& lhs, const safe_skip_iterator& rhs) {
+            return lhs.count == rhs.count;
+        }
+        safe_skip_iterator& operator++() {
+            count += 2;
+            return *this;
+        }
+        const T& operator*() {
+            return target[count];
+        }
+    };
+
+    iterator begin() const {
+        return m_data;
+    }
+
+    iterator end() const {
+        return m_data + m_size;
+    }
+
+    reverse_iterator rbegin() const {
+        return reverse_iterator(m_data + m_size);
+    }
+
+    reverse_iterator rend() const {
+        return reverse_iterator(m_data);
+    }
+
+    auto sbegin() {
+        return stride_view().begin();
+    }
+
+    auto send() {
+        return stride_view().end();
+    }
+
+    safe_skip_iterator ssbegin() const {
+        return {*this, 0};
+    }
+
+    safe_skip_iterator ssend() const {
+        return {*this, static_cast<std::ptrdiff_t>(m_size + m_size % 2)};
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const SmallVector& rhs) {
+        out << "[ ";
+        for (const auto& i : rhs) {
+            out << i << " ";
+        }
+        return out << "]";
+    }
+
+private:
+    using Alloc = std::allocator<T>;
+
+    T* m_data;
+    std::size_t m_capacity;
+    std::size_t m_size;
+    alignas(T) std::byte m_inline[N * sizeof(T)];
+
+    T* inlineData() {
+        return std::launder(reinterpret_cast<T*>(m_inline));
+    }
+
+    // destroys the elements and frees a heap buffer; leaves the object empty and inline
+    void reset() {
+        std::destroy_n(m_data, m_size);
+        if (!isInline()) Alloc{}.deallocate(m_data, m_capacity);
+        m_data = inlineData();
+        m_capacity = N;
+        m_size = 0;
+    }
+
+    // takes other's elements, stealing its buffer when it is on the heap;
+    // *this must be empty and inline
+    void take(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (other.isInline()) {
+            std::uninitialized_move_n(other.m_data, other.m_size, m_data);
+            m_size = other.m_size;
+            other.reset();
+        } else {
+            m_data = other.m_data;
+            m_capacity = other.m_capacity;
+            m_size = other.m_size;
+            other.m_data = other.inlineData();
+            other.m_capacity = N;
+            other.m_size = 0;
+        }
+    }
+
+    StridedView<T, 2> stride_view() const {
+        return stridedView<2>(m_data, m_size);
+    }
+};
+
+template <typename T, std::size_t N>
+SmallVector<T, N>::SmallVector() {
+    m_data = inlineData();
+    m_capacity = N;
+    m_size = 0;
+}
+
+template <typename T, std::size_t N>
+SmallVector<T, N>::SmallVector(std::size_t size) : SmallVector() {
+    if (size > N) {
+        m_data = Alloc{}.allocate(size);
+        m_capacity = size;
+    }
+    for (; m_size < size; m_size++) {
+        std::construct_at(m_data + m_size);
+    }
+}
+
+template <typename T, std::size_t N>
+SmallVector<T, N>::SmallVector(std::size_t size, const T& value) : SmallVector() {
+    if (size > N) {
+        m_data = Alloc{}.allocate(size);
+        m_capacity = size;
+    }
+    for (; m_size < size; m_size++) {
+        std::construct_at(m_data + m_size, value);
+    }
+}
+
+template <typename T, std::size_t N>
+SmallVector<T, N>::SmallVector(const SmallVector& other) : SmallVector() {
+    if (other.m_size > N) {
+        m_data = Alloc{}.allocate(other.m_size);
+        m_capacity = other.m_size;
+    }
+    for (; m_size < other.m_size; m_size++) {
+        std::construct_at(m_data + m_size, other.m_data[m_size]);
+    }
+}
+
+template <typename T, std::size_t N>
+SmallVector<T, N>::SmallVector(SmallVector&& other) noexcept(
+    std::is_nothrow_move_constructible_v<T>)
+    : SmallVector() {
+    take(other);
+}
+
+template <typename T, std::size_t N>
+SmallVector<T, N>::~SmallVector() {
+    reset();
+}
+
+template <typename T, std::size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(const SmallVector& other) {
+    if (this != &other) {
+        SmallVector copy(other);
+        reset();
+        take(copy);
+    }
+    return *this;
+}
+
+template <typename T, std::size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(SmallVector&& other) noexcept(
+    std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+        reset();
+        take(other);
+    }
+    return *this;
+}
+
+template <typename T, std::size_t N>
+const T& SmallVector<T, N>::operator[](std::size_t index) const {
+    return m_data[index];
+}
+
+template <typename T, std::size_t N>
+T& SmallVector<T, N>::operator[](std::size_t index) {
+    return m_data[index];
+}
+
+template <typename T, std::size_t N>
+std::size_t SmallVector<T, N>::size() const {
+    return m_size;
+}
+
+template <typename T, std::size_t N>
+std::size_t SmallVector<T, N>::capacity() const {
+    return m_capacity;
+}
+
+template <typename T, std::size_t N>
+bool SmallVector<T, N>::isInline() const {
+    return static_cast<const void*>(m_data) == static_cast<const void*>(m_inline);
+}
+
+template <typename T, std::size_t N>
+void SmallVector<T, N>::push_back(const T& element) {
+    emplace_back(element);
+}
+
+template <typename T, std::size_t N>
+void SmallVector<T, N>::push_back(T&& element) {
+    emplace_back(std::move(element));
+}
+
+template <typename T, std::size_t N>
+template <typename... Args>
+T& SmallVector<T, N>::emplace_back(Args&&... args) {
+    if (m_size < m_capacity) {
+        std::construct_at(m_data + m_size, std::forward<Args>(args)...);
+    } else {
+        // same order as Vector::emplace_back: args may refer into the old buffer
+        Alloc alloc;
+        if (m_capacity > detail::maxSize<T>(alloc) / 2) {
+            throw std::length_error("SmallVector too large");
+        }
+        const std::size_t new_capacity = m_capacity * 2;
+        T* new_data = alloc.allocate(new_capacity);
+        try {
+            std::construct_at(new_data + m_size, std::forward<Args>(args)...);
+        } catch (...) {
+            alloc.deallocate(new_data, new_capacity);
+            throw;
+        }
+        try {
+            detail::relocate(alloc, m_data, m_size, new_data);
+        } catch (...) {
+            std::destroy_at(new_data + m_size);
+            alloc.deallocate(new_data, new_capacity);
+            throw;
+        }
+        if (!isInline()) alloc.deallocate(m_data, m_capacity);
+        m_data = new_data;
+        m_capacity = new_capacity;
+    }
+    return m_data[m_size++];
+}
+
+template <typename T, std::size_t N>
+void SmallVector<T, N>::pop_back() {
+    if (m_size > 0) std::destroy_at(m_data + --m_size);
+}
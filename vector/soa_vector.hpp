@@ -0,0 +1,312 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "./vector.hpp"
+
+template <bool Const, typename... Fields>
+class SoaReference;
+
+template <bool Const, typename... Fields>
+class SoaIterator;
+
+// Vector of records with the given fields, stored as one Vector per field
+// ("structure of arrays"). column<I>() is the contiguous array of field I,
+// so a loop over one field streams only that array. Elements are accessed
+// through proxy references: (*it).get<I>() or
+//     auto [year, month, day] = dates[i];
+// bind to the stored fields, and a reference converts to and can be
+// assigned from std::tuple<Fields...>.
+template <typename... Fields>
+class SoaVector {
+    static_assert(sizeof...(Fields) > 0);
+
+public:
+    using value_type = std::tuple<Fields...>;
+    using reference = SoaReference<false, Fields...>;
+    using const_reference = SoaReference<true, Fields...>;
+    using iterator = SoaIterator<false, Fields...>;
+    using const_iterator = SoaIterator<true, Fields...>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    template <std::size_t I>
+    using field_type = std::tuple_element_t<I, value_type>;
+
+    std::size_t size() const {
+        return std::get<0>(m_columns).size();
+    }
+
+    std::size_t capacity() const {
+        return std::get<0>(m_columns).capacity();
+    }
+
+    void reserve(std::size_t capacity) {
+        std::apply([&](auto&... column) { (column.reserve(capacity), ...); }, m_columns);
+    }
+
+    void clear() {
+        std::apply([](auto&... column) { (column.clear(), ...); }, m_columns);
+    }
+
+    template <std::size_t I>
+    std::span<field_type<I>> column() {
+        return {std::get<I>(m_columns).data(), size()};
+    }
+
+    template <std::size_t I>
+    std::span<const field_type<I>> column() const {
+        return {std::get<I>(m_columns).data(), size()};
+    }
+
+    reference operator[](std::size_t index) {
+        return {&m_columns, index};
+    }
+
+    const_reference operator[](std::size_t index) const {
+        return {&m_columns, index};
+    }
+
+    void push_back(const Fields&... fields) {
+        append(std::index_sequence_for<Fields...>{}, fields...);
+    }
+
+    void push_back(Fields&&... fields) {
+        append(std::index_sequence_for<Fields...>{}, std::move(fields)...);
+    }
+
+    void push_back(const value_type& element) {
+        std::apply([this](const Fields&... fields) { push_back(fields...); }, element);
+    }
+
+    void pop_back() {
+        if (size() > 0) std::apply([](auto&... column) { (column.pop_back(), ...); }, m_columns);
+    }
+
+    iterator begin() {
+        return {&m_columns, 0};
+    }
+
+    iterator end() {
+        return {&m_columns, static_cast<std::ptrdiff_t>(size())};
+    }
+
+    const_iterator begin() const {
+        return {&m_columns, 0};
+    }
+
+    const_iterator end() const {
+        return {&m_columns, static_cast<std::ptrdiff_t>(size())};
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(begin());
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const SoaVector& rhs) {
+        out << "[ ";
+        for (const auto element : rhs) {
+            out << element << " ";
+        }
+        return out << "]";
+    }
+
+private:
+    std::tuple<Vector<Fields>...> m_columns;
+
+    // all columns or none: a throwing copy undoes the fields pushed before it
+    template <std::size_t... I, typename... Args>
+    void append(std::index_sequence<I...>, Args&&... fields) {
+        if (size() == capacity()) reserve(capacity() == 0 ? 1 : capacity() * 2);
+        std::size_t pushed{0};
+        try {
+            ((std::get<I>(m_columns).push_back(std::forward<Args>(fields)), ++pushed), ...);
+        } catch (...) {
+            ((I < pushed ? std::get<I>(m_columns).pop_back() : void()), ...);
+            throw;
+        }
+    }
+};
+
+// Element index of an SoaVector. Copying a reference copies the handle,
+// not the fields; assigning to one writes the fields.
+template <bool Const, typename... Fields>
+class SoaReference {
+    using Columns = std::conditional_t<Const, const std::tuple<Vector<Fields>...>,
+                                       std::tuple<Vector<Fields>...>>;
+
+public:
+    using value_type = std::tuple<Fields...>;
+
+    SoaReference(Columns* columns, std::size_t index) : m_columns{columns}, m_index{index} {}
+
+    // a const reference from a mutable one
+    operator SoaReference<true, Fields...>() const {
+        return {m_columns, m_index};
+    }
+
+    template <std::size_t I>
+    auto& get() const {
+        return std::get<I>(*m_columns)[m_index];
+    }
+
+    operator value_type() const {
+        return toTuple(std::index_sequence_for<Fields...>{});
+    }
+
+    const SoaReference& operator=(const value_type& value) const
+        requires(!Const)
+    {
+        assign(value, std::index_sequence_for<Fields...>{});
+        return *this;
+    }
+
+    const SoaReference& operator=(const SoaReference& other) const
+        requires(!Const)
+    {
+        assign(value_type(other), std::index_sequence_for<Fields...>{});
+        return *this;
+    }
+
+    friend bool operator==(const SoaReference& lhs, const value_type& rhs) {
+        return value_type(lhs) == rhs;
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const SoaReference& rhs) {
+        out << '(';
+        rhs.print(out, std::index_sequence_for<Fields...>{});
+        return out << ')';
+    }
+
+private:
+    template <std::size_t... I>
+    value_type toTuple(std::index_sequence<I...>) const {
+        return value_type(get<I>()...);
+    }
+
+    template <std::size_t... I>
+    void assign(const value_type& value, std::index_sequence<I...>) const {
+        ((get<I>() = std::get<I>(value)), ...);
+    }
+
+    template <std::size_t... I>
+    void print(std::ostream& out, std::index_sequence<I...>) const {
+        ((out << (I == 0 ? "" : ", ") << get<I>()), ...);
+    }
+
+    Columns* m_columns;
+    std::size_t m_index;
+};
+
+template <bool Const, typename... Fields>
+struct std::tuple_size<SoaReference<Const, Fields...>>
+    : std::integral_constant<std::size_t, sizeof...(Fields)> {};
+
+template <std::size_t I, bool Const, typename... Fields>
+struct std::tuple_element<I, SoaReference<Const, Fields...>> {
+    using type = std::conditional_t<Const, const std::tuple_element_t<I, std::tuple<Fields...>>,
+                                    std::tuple_element_t<I, std::tuple<Fields...>>>&;
+};
+
+template <bool Const, typename... Fields>
+class SoaIterator {
+    using Columns = std::conditional_t<Const, const std::tuple<Vector<Fields>...>,
+                                       std::tuple<Vector<Fields>...>>;
+
+public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::tuple<Fields...>;
+    using difference_type = std::ptrdiff_t;
+    using reference = SoaReference<Const, Fields...>;
+
+    SoaIterator() = default;
+    SoaIterator(Columns* columns, std::ptrdiff_t index) : m_columns{columns}, m_index{index} {}
+
+    reference operator*() const {
+        return {m_columns, static_cast<std::size_t>(m_index)};
+    }
+
+    reference operator[](difference_type n) const {
+        return {m_columns, static_cast<std::size_t>(m_index + n)};
+    }
+
+    SoaIterator& operator++() {
+        ++m_index;
+        return *this;
+    }
+
+    SoaIterator operator++(int) {
+        auto old = *this;
+        ++m_index;
+        return old;
+    }
+
+    SoaIterator& operator--() {
+        --m_index;
+        return *this;
+    }
+
+    SoaIterator operator--(int) {
+        auto old = *this;
+        --m_index;
+        return old;
+    }
+
+    SoaIterator& operator+=(difference_type n) {
+        m_index += n;
+        return *this;
+    }
+
+    SoaIterator& operator-=(difference_type n) {
+        m_index -= n;
+        return *this;
+    }
+
+    friend SoaIterator operator+(SoaIterator it, difference_type n) {
+        return it += n;
+    }
+
+    friend SoaIterator operator+(difference_type n, SoaIterator it) {
+        return it += n;
+    }
+
+    friend SoaIterator operator-(SoaIterator it, difference_type n) {
+        return it -= n;
+    }
+
+    friend difference_type operator-(const SoaIterator& lhs, const SoaIterator& rhs) {
+        return lhs.m_index - rhs.m_index;
+    }
+
+    friend bool operator==(const SoaIterator& lhs, const SoaIterator& rhs) {
+        return lhs.m_index == rhs.m_index;
+    }
+
+    friend std::strong_ordering operator<=>(const SoaIterator& lhs, const SoaIterator& rhs) {
+        return lhs.m_index <=> rhs.m_index;
+    }
+
+private:
+    Columns* m_columns{nullptr};
+    std::ptrdiff_t m_index{0};
+};
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Views over every Stride-th element of a buffer, e.g. one channel of an
+// interleaved multichannel signal. The stride is a template argument when
+// it is known at compile time, or DYNAMIC_STRIDE to pass it at runtime.
+// With a compile-time stride of 1 the view is a contiguous_range of plain
+// pointers.
+//
+// The bulk members (sum, copyTo, copyFrom, fill, transform) are flat loops
+// over base()[i * stride()], four elements per step where the elements are
+// independent, so the compiler can vectorize them (gathers, or shuffles
+// for a constant stride). A runtime stride that happens to be 1 takes the
+// contiguous version of the loop.
+
+inline constexpr std::ptrdiff_t DYNAMIC_STRIDE{0};
+
+namespace detail {
+template <std::ptrdiff_t Stride>
+struct StrideStorage {
+    constexpr StrideStorage(std::ptrdiff_t = Stride) {}
+
+    static constexpr std::ptrdiff_t get() {
+        return Stride;
+    }
+};
+
+template <>
+struct StrideStorage<DYNAMIC_STRIDE> {
+    std::ptrdiff_t value{1};
+
+    constexpr StrideStorage(std::ptrdiff_t stride = 1) : value{stride} {}
+
+    constexpr std::ptrdiff_t get() const {
+        return value;
+    }
+};
+
+// calls f(stride), with the stride as a compile-time constant when it is
+// one, so f's loop gets a contiguous instantiation
+template <std::ptrdiff_t Stride, typename F>
+constexpr decltype(auto) withStride(std::ptrdiff_t stride, F&& f) {
+    if constexpr (Stride != DYNAMIC_STRIDE) {
+        return f(std::integral_constant<std::ptrdiff_t, Stride>{});
+    } else if (stride == 1) {
+        return f(std::integral_constant<std::ptrdiff_t, 1>{});
+    } else {
+        return f(stride);
+    }
+}
+}  // namespace detail
+
+// Position i of a strided view. Keeps the base pointer and an index rather
+// than a moving pointer, so end() never points past the buffer.
+template <typename T, std::ptrdiff_t Stride>
+class StridedIterator {
+public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    constexpr StridedIterator() = default;
+    constexpr StridedIterator(T* base, std::ptrdiff_t index, std::ptrdiff_t stride)
+        : m_base{base}, m_index{index}, m_stride{stride} {}
+
+    constexpr T& operator*() const {
+        return m_base[m_index * m_stride.get()];
+    }
+
+    constexpr T& operator[](difference_type n) const {
+        return m_base[(m_index + n) * m_stride.get()];
+    }
+
+    constexpr StridedIterator& operator++() {
+        ++m_index;
+        return *this;
+    }
+
+    constexpr StridedIterator operator++(int) {
+        auto old = *this;
+        ++m_index;
+        return old;
+    }
+
+    constexpr StridedIterator& operator--() {
+        --m_index;
+        return *this;
+    }
+
+    constexpr StridedIterator operator--(int) {
+        auto old = *this;
+        --m_index;
+        return old;
+    }
+
+    constexpr StridedIterator& operator+=(difference_type n) {
+        m_index += n;
+        return *this;
+    }
+
+    constexpr StridedIterator& operator-=(difference_type n) {
+        m_index -= n;
+        return *this;
+    }
+
+    friend constexpr StridedIterator operator+(StridedIterator it, difference_type n) {
+        return it += n;
+    }
+
+    friend constexpr StridedIterator operator+(difference_type n, StridedIterator it) {
+        return it += n;
+    }
+
+    friend constexpr StridedIterator operator-(StridedIterator it, difference_type n) {
+        return it -= n;
+    }
+
+    friend constexpr difference_type operator-(const StridedIterator& lhs,
+                                               const StridedIterator& rhs) {
+        return lhs.m_index - rhs.m_index;
+    }
+
+    // only iterators of the same view compare meaningfully
+    friend constexpr bool operator==(const StridedIterator& lhs, const StridedIterator& rhs) {
+        return lhs.m_index == rhs.m_index;
+    }
+
+    friend constexpr std::strong_ordering operator<=>(const StridedIterator& lhs,
+                                                      const StridedIterator& rhs) {
+        return lhs.m_index <=> rhs.m_index;
+    }
+
+private:
+    T* m_base{nullptr};
+    std::ptrdiff_t m_index{0};
+    [[no_unique_address]] detail::StrideStorage<Stride> m_stride;
+};
+
+template <typename T, std::ptrdiff_t Stride = DYNAMIC_STRIDE>
+class StridedView : public std::ranges::view_interface<StridedView<T, Stride>> {
+    static_assert(Stride >= 0, "a stride must be positive");
+
+public:
+    using iterator = std::conditional_t<Stride == 1, T*, StridedIterator<T, Stride>>;
+
+    constexpr StridedView() = default;
+
+    // count elements, the first at first and each stride elements after the
+    // previous; throws std::invalid_argument unless stride is positive
+    constexpr StridedView(T* first, std::size_t count,
+                          std::ptrdiff_t stride = Stride == DYNAMIC_STRIDE ? 1 : Stride)
+        : m_first{first}, m_count{count}, m_stride{stride} {
+        if (stride <= 0) throw std::invalid_argument("A stride must be positive");
+    }
+
+    constexpr iterator begin() const {
+        if constexpr (Stride == 1) {
+            return m_first;
+        } else {
+            return {m_first, 0, stride()};
+        }
+    }
+
+    constexpr iterator end() const {
+        if constexpr (Stride == 1) {
+            return m_first + m_count;
+        } else {
+            return {m_first, static_cast<std::ptrdiff_t>(m_count), stride()};
+        }
+    }
+
+    constexpr std::size_t size() const {
+        return m_count;
+    }
+
+    constexpr std::ptrdiff_t stride() const {
+        return m_stride.get();
+    }
+
+    // address of the first element
+    constexpr T* base() const {
+        return m_first;
+    }
+
+    constexpr T& operator[](std::size_t index) const {
+        return m_first[static_cast<std::ptrdiff_t>(index) * stride()];
+    }
+
+    // Sum of the elements. Four running sums take every fourth element, so
+    // floating-point results may differ in the last bits from a plain loop.
+    std::remove_cv_t<T> sum() const {
+        return detail::withStride<Stride>(stride(), [&](auto s) {
+            using V = std::remove_cv_t<T>;
+            const T* p = m_first;
+            V acc0{}, acc1{}, acc2{}, acc3{};
+            std::size_t i{0};
+            for (; i + 4 <= m_count; i += 4) {
+                acc0 += p[(i + 0) * s];
+                acc1 += p[(i + 1) * s];
+                acc2 += p[(i + 2) * s];
+                acc3 += p[(i + 3) * s];
+            }
+            for (; i < m_count; ++i) acc0 += p[i * s];
+            return (acc0 + acc1) + (acc2 + acc3);
+        });
+    }
+
+    // gathers the elements into out[0, size()); returns the end of the output
+    template <typename U>
+    U* copyTo(U* out) const {
+        return detail::withStride<Stride>(stride(), [&](auto s) {
+            const T* p = m_first;
+            for (std::size_t i{0}; i < m_count; ++i) out[i] = p[i * s];
+            return out + m_count;
+        });
+    }
+
+    // scatters in[0, size()) into the elements
+    template <typename U>
+    void copyFrom(const U* in) const {
+        detail::withStride<Stride>(stride(), [&](auto s) {
+            for (std::size_t i{0}; i < m_count; ++i) m_first[i * s] = in[i];
+        });
+    }
+
+    void fill(const std::remove_cv_t<T>& value) const {
+        detail::withStride<Stride>(stride(), [&](auto s) {
+            for (std::size_t i{0}; i < m_count; ++i) m_first[i * s] = value;
+        });
+    }
+
+    // out[i] = f(element i); f should be free of side effects
+    template <typename U, typename F>
+    U* transform(U* out, F f) const {
+        return detail::withStride<Stride>(stride(), [&](auto s) {
+            const T* p = m_first;
+            for (std::size_t i{0}; i < m_count; ++i) out[i] = f(p[i * s]);
+            return out + m_count;
+        });
+    }
+
+private:
+    T* m_first{nullptr};
+    std::size_t m_count{0};
+    [[no_unique_address]] detail::StrideStorage<Stride> m_stride;
+};
+
+// iterators point into the viewed buffer, not into the view
+namespace std::ranges {
+template <typename T, std::ptrdiff_t Stride>
+inline constexpr bool enable_borrowed_range<StridedView<T, Stride>> = true;
+}  // namespace std::ranges
+
+// every Stride-th of the n elements at first, starting with the first one
+template <std::ptrdiff_t Stride, typename T>
+constexpr StridedView<T, Stride> stridedView(T* first, std::size_t n) {
+    static_assert(Stride > 0);
+    return {first, (n + Stride - 1) / Stride};
+}
+
+// throws std::invalid_argument unless stride is positive
+template <typename T>
+constexpr StridedView<T> stridedView(T* first, std::size_t n, std::ptrdiff_t stride) {
+    if (stride <= 0) throw std::invalid_argument("A stride must be positive");
+    const auto step = static_cast<std::size_t>(stride);
+    return {first, (n + step - 1) / step, stride};
+}
@@ -0,0 +1,651 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "./checked_iterator.hpp"
+#include "./growth.hpp"
+#include "./strided.hpp"
+
+// Types whose objects may be moved to a new address with a plain memcpy,
+// leaving the old bytes as dead storage. Specialize for types that are not
+// trivially copyable but still qualify.
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+constexpr bool isTriviallyRelocatable = IsTriviallyRelocatable<T>::value;
+
+namespace detail {
+template <typename Alloc, typename T>
+void destroyN(Alloc& alloc, T* first, std::size_t n) {
+    for (std::size_t i = 0; i < n; i++) std::allocator_traits<Alloc>::destroy(alloc, first + i);
+}
+
+// builds copies of n objects from first in raw storage at dest, moving only
+// when that cannot throw, so a failure leaves the source intact; on failure
+// the copies built so far are destroyed
+template <typename Alloc, typename T>
+void moveConstruct(Alloc& alloc, T* first, std::size_t n, T* dest) {
+    std::size_t i = 0;
+    try {
+        for (; i < n; i++) {
+            std::allocator_traits<Alloc>::construct(alloc, dest + i,
+                                                    std::move_if_noexcept(first[i]));
+        }
+    } catch (...) {
+        destroyN(alloc, dest, i);
+        throw;
+    }
+}
+
+// moves n live objects from first into raw storage at dest and ends their
+// lifetime at first; dest must not overlap [first, first + n)
+template <typename Alloc, typename T>
+void relocate(Alloc& alloc, T* first, std::size_t n, T* dest) {
+    if (n == 0) return;
+    if constexpr (isTriviallyRelocatable<T>) {
+        std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(T));
+    } else {
+        moveConstruct(alloc, first, n, dest);
+        destroyN(alloc, first, n);
+    }
+}
+
+// the most elements one buffer can hold; keeps byte sizes and pointer
+// differences within std::ptrdiff_t
+template <typename T, typename Alloc>
+std::size_t maxSize(const Alloc& alloc) {
+    const std::size_t limit = PTRDIFF_MAX / sizeof(T);
+    const std::size_t max = std::allocator_traits<Alloc>::max_size(alloc);
+    return max < limit ? max : limit;
+}
+}  // namespace detail
+
+// Growth decides how the capacity changes, see growth.hpp.
+template <typename T, typename Alloc = std::allocator<T>, typename Growth = growth::Double>
+struct Vector {
+public:
+    using allocator_type = Alloc;
+
+    Vector() : Vector(Alloc()) {}
+    explicit Vector(const Alloc& alloc);
+    Vector(std::size_t size, const Alloc& alloc = Alloc());
+    Vector(std::size_t size, const T& value, const Alloc& alloc = Alloc());
+    Vector(const Vector& other);
+    Vector(const Vector& other, const Alloc& alloc);
+    Vector(Vector&& other) noexcept;
+    ~Vector();
+    Vector& operator=(const Vector& other);
+    Vector& operator=(Vector&& other) noexcept(
+        std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value ||
+        std::allocator_traits<Alloc>::is_always_equal::value);
+    const T& operator[](std::size_t index) const;
+    T& operator[](std::size_t index);
+    std::size_t size() const;
+    T* data() const;
+    std::size_t capacity() const;
+    std::size_t max_size() const;
+    allocator_type get_allocator() const;
+    void reserve(std::size_t capacity);
+    void resize(std::size_t size);
+    void resize(std::size_t size, const T& value);
+    void shrink_to_fit();
+    // destroys the elements but keeps the buffer
+    void clear();
+    void push_back(const T& element);
+    void push_back(T&& element);
+    template <typename... Args>
+    T& emplace_back(Args&&... args);
+    void pop_back();
+
+#if VECTOR_CHECKED_ITERATORS
+    using iterator = CheckedIterator<T, Vector>;
+
+    // bumped whenever the buffer moves, which invalidates all iterators
+    std::size_t generation() const {
+        return m_generation;
+    }
+#else
+    using iterator = T*;
+#endif
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    // The range operations below work out the final size first and
+    // reallocate at most once. insert and append_range accept ranges over
+    // this Vector's own elements.
+    template <std::input_iterator It, std::sentinel_for<It> S>
+    iterator insert(iterator pos, It first, S last);
+    template <std::ranges::input_range R>
+    void append_range(R&& range);
+    template <std::ranges::input_range R>
+    void assign_range(R&& range);
+    iterator erase(iterator pos);
+    iterator erase(iterator first, iterator last);
+
+    struct safe_skip_iterator {
+        const Vector& target;
+        std::ptrdiff_t count{0};
+
+        friend bool operator==(const safe_skip_iterator& lhs, const safe_skip_iterator& rhs) {
+            return lhs.count == rhs.count;
+        }
+        safe_skip_iterator& operator++() {
+            count += 2;
+            return *this;
+        }
+        const T& operator*() {
+            return target[count];
+        }
+    };
+
+    iterator begin() const {
+        return makeIterator(m_data);
+    }
+
+    iterator end() const {
+        return makeIterator(m_data + m_size);
+    }
+
+    reverse_iterator rbegin() const {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() const {
+        return reverse_iterator(begin());
+    }
+
+    auto sbegin() {
+        return stride_view().begin();
+    }
+
+    auto send() {
+        return stride_view().end();
+    }
+
+    // every stride-th element from offset on, e.g. one channel of
+    // interleaved samples; stride must be positive and offset at most size()
+    StridedView<T> strided(std::ptrdiff_t stride, std::size_t offset = 0) const {
+        if (offset > m_size) throw std::out_of_range("Offset past the end of the Vector");
+        return stridedView(m_data + offset, m_size - offset, stride);
+    }
+
+    safe_skip_iterator ssbegin() const {
+        return {*this, 0};
+    }
+
+    safe_skip_iterator ssend() const {
+        return {*this, static_cast<std::ptrdiff_t>(m_size + m_size % 2)};
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const Vector& rhs) {
+        out << "[ ";
+        for (const auto& i : rhs) {
+            out << i << " ";
+        }
+        return out << "]";
+    }
+
+private:
+    using traits = std::allocator_traits<Alloc>;
+
+    T* m_data;
+    std::size_t m_capacity;
+    std::size_t m_size;
+    [[no_unique_address]] Alloc m_alloc;
+#if VECTOR_CHECKED_ITERATORS
+    std::size_t m_generation{0};
+#endif
+
+    iterator makeIterator(T* p) const {
+#if VECTOR_CHECKED_ITERATORS
+        return iterator(this, p);
+#else
+        return p;
+#endif
+    }
+
+    // called whenever m_data changes
+    void invalidateIterators() {
+#if VECTOR_CHECKED_ITERATORS
+        ++m_generation;
+#endif
+    }
+
+    // storage is raw: only [0, m_size) holds constructed objects
+    T* allocate(std::size_t n) {
+        return n > 0 ? traits::allocate(m_alloc, n) : nullptr;
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        if (p) traits::deallocate(m_alloc, p, n);
+    }
+
+    void release() {
+        detail::destroyN(m_alloc, m_data, m_size);
+        deallocate(m_data, m_capacity);
+    }
+
+    // moves the elements into a fresh buffer of new_capacity >= m_size
+    void reallocate(std::size_t new_capacity) {
+        T* new_data = allocate(new_capacity);
+        try {
+            detail::relocate(m_alloc, m_data, m_size, new_data);
+        } catch (...) {
+            deallocate(new_data, new_capacity);
+            throw;
+        }
+        deallocate(m_data, m_capacity);
+        m_data = new_data;
+        m_capacity = new_capacity;
+        invalidateIterators();
+    }
+
+    // what Growth suggests for holding required elements, capped at max_size()
+    std::size_t grownCapacity(std::size_t required) const {
+        const std::size_t limit = max_size();
+        if (required > limit) throw std::length_error("Vector too large");
+        const std::size_t capacity = Growth::grow(m_capacity, required, sizeof(T));
+        return capacity < required ? required : capacity > limit ? limit : capacity;
+    }
+
+    // inserts the count elements starting at first before element index
+    template <typename It>
+    iterator insertCounted(std::size_t index, It first, std::size_t count);
+
+    void destroyFrom(std::size_t size) {
+        while (m_size > size) traits::destroy(m_alloc, m_data + --m_size);
+    }
+
+    // takes over other's buffer, which must come from an allocator equal to ours
+    void take(Vector& other) noexcept {
+        m_data = other.m_data;
+        m_capacity = other.m_capacity;
+        m_size = other.m_size;
+        other.m_data = nullptr;
+        other.m_capacity = 0;
+        other.m_size = 0;
+        invalidateIterators();
+        other.invalidateIterators();
+    }
+
+    StridedView<T, 2> stride_view() const {
+        return stridedView<2>(m_data, m_size);
+    }
+};
+
+// the other constructors delegate here first, so the destructor cleans up
+// the elements built so far if one of them throws
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>::Vector(const Alloc& alloc) : m_alloc{alloc} {
+    m_data = nullptr;
+    m_capacity = 0;
+    m_size = 0;
+}
+
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>::Vector(std::size_t size, const Alloc& alloc) : Vector(alloc) {
+    m_data = allocate(size);
+    m_capacity = size;
+    for (; m_size < size; m_size++) {
+        traits::construct(m_alloc, m_data + m_size);
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>::Vector(std::size_t size, const T& value, const Alloc& alloc) : Vector(alloc) {
+    m_data = allocate(size);
+    m_capacity = size;
+    for (; m_size < size; m_size++) {
+        traits::construct(m_alloc, m_data + m_size, value);
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>::~Vector() {
+    release();
+}
+
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>::Vector(const Vector& other)
+    : Vector(other, traits::select_on_container_copy_construction(other.m_alloc)) {}
+
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>::Vector(const Vector& other, const Alloc& alloc) : Vector(alloc) {
+    m_data = allocate(other.m_size);
+    m_capacity = other.m_size;
+    for (; m_size < other.m_size; m_size++) {
+        traits::construct(m_alloc, m_data + m_size, other.m_data[m_size]);
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>::Vector(Vector&& other) noexcept : m_alloc{std::move(other.m_alloc)} {
+    take(other);
+}
+
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>& Vector<T, Alloc, Growth>::operator=(const Vector& other) {
+    if (this != &other) {
+        constexpr bool propagate = traits::propagate_on_container_copy_assignment::value;
+        Vector copy(other, propagate ? other.m_alloc : m_alloc);
+        release();
+        if constexpr (propagate) m_alloc = other.m_alloc;
+        take(copy);
+    }
+    return *this;
+}
+
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>& Vector<T, Alloc, Growth>::operator=(Vector&& other) noexcept(
+    std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value ||
+    std::allocator_traits<Alloc>::is_always_equal::value) {
+    if (this == &other) return *this;
+    if constexpr (traits::propagate_on_container_move_assignment::value) {
+        release();
+        m_alloc = std::move(other.m_alloc);
+        take(other);
+    } else {
+        if (m_alloc == other.m_alloc) {
+            release();
+            take(other);
+        } else {
+            // other's buffer belongs to a different resource: move the elements over
+            Vector moved(m_alloc);
+            moved.m_data = moved.allocate(other.m_size);
+            moved.m_capacity = other.m_size;
+            for (; moved.m_size < other.m_size; moved.m_size++) {
+                traits::construct(m_alloc, moved.m_data + moved.m_size,
+                                  std::move(other.m_data[moved.m_size]));
+            }
+            release();
+            take(moved);
+        }
+    }
+    return *this;
+}
+
+template <typename T, typename Alloc, typename Growth>
+const T& Vector<T, Alloc, Growth>::operator[](std::size_t index) const {
+    return m_data[index];
+}
+
+template <typename T, typename Alloc, typename Growth>
+T& Vector<T, Alloc, Growth>::operator[](std::size_t index) {
+    return m_data[index];
+}
+
+template <typename T, typename Alloc, typename Growth>
+std::size_t Vector<T, Alloc, Growth>::size() const {
+    return m_size;
+}
+
+template <typename T, typename Alloc, typename Growth>
+T* Vector<T, Alloc, Growth>::data() const {
+    return m_data;
+}
+
+template <typename T, typename Alloc, typename Growth>
+std::size_t Vector<T, Alloc, Growth>::capacity() const {
+    return m_capacity;
+}
+
+template <typename T, typename Alloc, typename Growth>
+std::size_t Vector<T, Alloc, Growth>::max_size() const {
+    return detail::maxSize<T>(m_alloc);
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::allocator_type Vector<T, Alloc, Growth>::get_allocator() const {
+    return m_alloc;
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::push_back(const T& element) {
+    emplace_back(element);
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::push_back(T&& element) {
+    emplace_back(std::move(element));
+}
+
+template <typename T, typename Alloc, typename Growth>
+template <typename... Args>
+T& Vector<T, Alloc, Growth>::emplace_back(Args&&... args) {
+    if (m_capacity > m_size) {
+        traits::construct(m_alloc, m_data + m_size, std::forward<Args>(args)...);
+    } else {
+        const std::size_t new_capacity = grownCapacity(m_size + 1);
+        T* new_data = allocate(new_capacity);
+        // build the new element first: args may refer into the old buffer
+        try {
+            traits::construct(m_alloc, new_data + m_size, std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(new_data, new_capacity);
+            throw;
+        }
+        try {
+            detail::relocate(m_alloc, m_data, m_size, new_data);
+        } catch (...) {
+            traits::destroy(m_alloc, new_data + m_size);
+            deallocate(new_data, new_capacity);
+            throw;
+        }
+        deallocate(m_data, m_capacity);
+        m_data = new_data;
+        m_capacity = new_capacity;
+        invalidateIterators();
+    }
+    return m_data[m_size++];
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::pop_back() {
+    if (m_size == 0) return;
+    traits::destroy(m_alloc, m_data + --m_size);
+    const std::size_t new_capacity = Growth::shrink(m_capacity, m_size);
+    if (new_capacity < m_capacity) {
+        // shrinking only saves memory: keep the old buffer if it fails
+        try {
+            reallocate(new_capacity);
+        } catch (...) {
+        }
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::reserve(std::size_t capacity) {
+    if (capacity > max_size()) throw std::length_error("Vector::reserve");
+    if (capacity > m_capacity) reallocate(capacity);
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::resize(std::size_t size) {
+    destroyFrom(size);
+    if (size > m_capacity) reallocate(grownCapacity(size));
+    for (; m_size < size; m_size++) {
+        traits::construct(m_alloc, m_data + m_size);
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::resize(std::size_t size, const T& value) {
+    destroyFrom(size);
+    if (size > m_capacity) {
+        // value may be one of our elements, which the reallocation moves
+        const T copy(value);
+        reallocate(grownCapacity(size));
+        for (; m_size < size; m_size++) {
+            traits::construct(m_alloc, m_data + m_size, copy);
+        }
+    } else {
+        for (; m_size < size; m_size++) {
+            traits::construct(m_alloc, m_data + m_size, value);
+        }
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::shrink_to_fit() {
+    if (m_size < m_capacity) reallocate(m_size);
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::clear() {
+    destroyFrom(0);
+}
+
+template <typename T, typename Alloc, typename Growth>
+template <std::input_iterator It, std::sentinel_for<It> S>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::insert(iterator pos, It first,
+                                                                             S last) {
+    const std::size_t index = static_cast<std::size_t>(pos - begin());
+    if constexpr (!std::forward_iterator<It>) {
+        // a single-pass range is collected first, so its length is known
+        Vector buffered(m_alloc);
+        for (; first != last; ++first) buffered.emplace_back(*first);
+        return insertCounted(index, std::make_move_iterator(buffered.m_data), buffered.m_size);
+    } else {
+        return insertCounted(index, first,
+                             static_cast<std::size_t>(std::ranges::distance(first, last)));
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+template <typename It>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::insertCounted(
+    std::size_t index, It first, std::size_t count) {
+    if (count > max_size() - m_size) throw std::length_error("Vector too large");
+    if (m_size + count <= m_capacity) {
+        // build the new elements at the end, then rotate them into place
+        const std::size_t old_size = m_size;
+        try {
+            for (; m_size < old_size + count; ++first, ++m_size) {
+                traits::construct(m_alloc, m_data + m_size, *first);
+            }
+        } catch (...) {
+            destroyFrom(old_size);
+            throw;
+        }
+        std::rotate(m_data + index, m_data + old_size, m_data + m_size);
+        return makeIterator(m_data + index);
+    }
+    // the new elements go straight to their place in the new buffer, then
+    // the old elements are moved around them
+    const std::size_t new_capacity = grownCapacity(m_size + count);
+    T* new_data = allocate(new_capacity);
+    std::size_t built = 0;
+    try {
+        for (; built < count; ++first, ++built) {
+            traits::construct(m_alloc, new_data + index + built, *first);
+        }
+        if constexpr (isTriviallyRelocatable<T>) {
+            detail::relocate(m_alloc, m_data, index, new_data);
+            detail::relocate(m_alloc, m_data + index, m_size - index, new_data + index + count);
+        } else {
+            detail::moveConstruct(m_alloc, m_data, index, new_data);
+            try {
+                detail::moveConstruct(m_alloc, m_data + index, m_size - index,
+                                      new_data + index + count);
+            } catch (...) {
+                detail::destroyN(m_alloc, new_data, index);
+                throw;
+            }
+            detail::destroyN(m_alloc, m_data, m_size);
+        }
+    } catch (...) {
+        detail::destroyN(m_alloc, new_data + index, built);
+        deallocate(new_data, new_capacity);
+        throw;
+    }
+    deallocate(m_data, m_capacity);
+    m_data = new_data;
+    m_capacity = new_capacity;
+    m_size += count;
+    invalidateIterators();
+    return makeIterator(m_data + index);
+}
+
+template <typename T, typename Alloc, typename Growth>
+template <std::ranges::input_range R>
+void Vector<T, Alloc, Growth>::append_range(R&& range) {
+    insert(end(), std::ranges::begin(range), std::ranges::end(range));
+}
+
+template <typename T, typename Alloc, typename Growth>
+template <std::ranges::input_range R>
+void Vector<T, Alloc, Growth>::assign_range(R&& range) {
+    if constexpr (!std::ranges::forward_range<R>) {
+        clear();
+        append_range(range);
+    } else {
+        auto first = std::ranges::begin(range);
+        const auto last = std::ranges::end(range);
+        const std::size_t count = static_cast<std::size_t>(std::ranges::distance(range));
+        if (count > m_capacity) {
+            if (count > max_size()) throw std::length_error("Vector too large");
+            Vector fresh(m_alloc);
+            fresh.m_data = fresh.allocate(count);
+            fresh.m_capacity = count;
+            for (; first != last; ++first, ++fresh.m_size) {
+                traits::construct(m_alloc, fresh.m_data + fresh.m_size, *first);
+            }
+            release();
+            take(fresh);
+            return;
+        }
+        // reuse the buffer: assign over the existing elements, then build
+        // or destroy the difference
+        std::size_t i = 0;
+        for (; i < m_size && first != last; ++i, ++first) m_data[i] = *first;
+        destroyFrom(i);
+        for (; first != last; ++first, ++m_size) {
+            traits::construct(m_alloc, m_data + m_size, *first);
+        }
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::erase(iterator pos) {
+    return erase(pos, pos + 1);
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::erase(iterator first,
+                                                                            iterator last) {
+    const std::size_t index = static_cast<std::size_t>(first - begin());
+    const std::size_t count = static_cast<std::size_t>(last - first);
+    if (count > 0) {
+        std::move(m_data + index + count, m_data + m_size, m_data + index);
+        destroyFrom(m_size - count);
+    }
+    return makeIterator(m_data + index);
+}
+
+// removes the elements matching pred in one pass; returns how many there were
+template <typename T, typename Alloc, typename Growth, typename Pred>
+std::size_t erase_if(Vector<T, Alloc, Growth>& vector, Pred pred) {
+    T* const first = vector.data();
+    T* const last = first + vector.size();
+    T* const kept = std::remove_if(first, last, pred);
+    vector.erase(vector.begin() + (kept - first), vector.end());
+    return static_cast<std::size_t>(last - kept);
+}
+
+namespace pmr {
+// Vectors drawing from a std::pmr::memory_resource, e.g. a request-scoped
+// std::pmr::monotonic_buffer_resource released in one go
+template <typename T, typename Growth = growth::Double>
+using Vector = ::Vector<T, std::pmr::polymorphic_allocator<T>, Growth>;
+}  // namespace pmr
@@ -0,0 +1,319 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "../common/mapped_file.hpp"
+#include "./vector.hpp"
+
+// On-disk format for Vectors of trivially copyable elements:
+//
+//     [0, 56)        VectorFileHeader
+//     [56, 4096)     zero bytes
+//     [4096, ...)    the elements, exactly as they lie in memory
+//
+// The data starts on a page boundary, so a mapping of the file yields
+// correctly aligned elements without copying them. The header records the
+// element size and alignment and the byte order of the writer, which are
+// checked on loading (the element type itself is not recorded), and a
+// checksum of the element bytes. Only the first count elements are valid;
+// anything after them is the torn tail of an interrupted append.
+
+struct VectorFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint64_t elementSize;
+    std::uint64_t elementAlign;
+    std::uint64_t count;
+    std::uint64_t dataOffset;
+    std::uint64_t checksum;
+};
+
+enum class VectorFileMode {
+    // start a new file, replacing any old one
+    Create,
+    // continue after the elements of an existing file
+    Append,
+};
+
+namespace detail {
+inline constexpr char VECTOR_FILE_MAGIC[8]{'C', 'X', 'X', 'V', 'E', 'C', '\r', '\n'};
+inline constexpr std::uint32_t VECTOR_FILE_VERSION{1};
+inline constexpr std::uint32_t VECTOR_FILE_BYTE_ORDER{0x01020304};
+inline constexpr std::uint64_t VECTOR_FILE_DATA_OFFSET{4096};
+inline constexpr std::uint64_t FNV_OFFSET{0xcbf29ce484222325};
+inline constexpr std::uint64_t FNV_PRIME{0x100000001b3};
+
+// 64-bit FNV-1a of bytes, continued from hash, so a checksum can be
+// extended as elements are appended
+inline std::uint64_t checksum(const void* data, std::size_t bytes,
+                              std::uint64_t hash = FNV_OFFSET) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < bytes; i++) hash = (hash ^ p[i]) * FNV_PRIME;
+    return hash;
+}
+
+template <typename T>
+void checkFileElement() {
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements go to files");
+    static_assert(alignof(T) <= VECTOR_FILE_DATA_OFFSET);
+}
+
+template <typename T>
+VectorFileHeader makeFileHeader(std::uint64_t count, std::uint64_t checksum) {
+    VectorFileHeader header{};
+    std::memcpy(header.magic, VECTOR_FILE_MAGIC, sizeof header.magic);
+    header.version = VECTOR_FILE_VERSION;
+    header.byteOrder = VECTOR_FILE_BYTE_ORDER;
+    header.elementSize = sizeof(T);
+    header.elementAlign = alignof(T);
+    header.count = count;
+    header.dataOffset = VECTOR_FILE_DATA_OFFSET;
+    header.checksum = checksum;
+    return header;
+}
+
+// throws unless header describes count Ts that fit in a file of fileSize bytes
+template <typename T>
+void checkFileHeader(const VectorFileHeader& header, std::uint64_t fileSize) {
+    if (fileSize < sizeof header || std::memcmp(header.magic, VECTOR_FILE_MAGIC, 8) != 0) {
+        throw std::runtime_error("Not a Vector file");
+    }
+    if (header.version != VECTOR_FILE_VERSION) {
+        throw std::runtime_error("Unsupported Vector file version");
+    }
+    if (header.byteOrder != VECTOR_FILE_BYTE_ORDER) {
+        throw std::runtime_error("Vector file has a different byte order");
+    }
+    if (header.elementSize != sizeof(T) || header.elementAlign != alignof(T)) {
+        throw std::runtime_error("Vector file holds a different element type");
+    }
+    if (header.dataOffset < sizeof header || header.dataOffset % alignof(T) != 0 ||
+        header.dataOffset > fileSize || header.count > (fileSize - header.dataOffset) / sizeof(T)) {
+        throw std::runtime_error("Vector file is truncated");
+    }
+}
+}  // namespace detail
+
+// The elements of a Vector file, read straight from a read-only mapping of
+// it: opening costs one page fault for the header, and element pages are
+// read in by the OS on first touch. Only the header is checked on opening;
+// verify() reads every element to compare the checksum. Later appends to
+// the file are not seen. Move-only, like the mapping it owns.
+template <typename T>
+class VectorFileView {
+public:
+    using value_type = T;
+    using iterator = const T*;
+
+    VectorFileView() = default;
+
+    explicit VectorFileView(const std::filesystem::path& path) : m_mapping{path} {
+        detail::checkFileElement<T>();
+        VectorFileHeader header{};
+        if (m_mapping.size() >= sizeof header) std::memcpy(&header, m_mapping.data(), sizeof header);
+        detail::checkFileHeader<T>(header, m_mapping.size());
+        m_data = reinterpret_cast<const T*>(m_mapping.data() + header.dataOffset);
+        m_size = static_cast<std::size_t>(header.count);
+        m_checksum = header.checksum;
+    }
+
+    std::size_t size() const {
+        return m_size;
+    }
+
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    const T* data() const {
+        return m_data;
+    }
+
+    const T& operator[](std::size_t index) const {
+        return m_data[index];
+    }
+
+    iterator begin() const {
+        return m_data;
+    }
+
+    iterator end() const {
+        return m_data + m_size;
+    }
+
+    operator std::span<const T>() const {
+        return {m_data, m_size};
+    }
+
+    // the checksum recorded in the header
+    std::uint64_t checksum() const {
+        return m_checksum;
+    }
+
+    // whether the elements still match the checksum in the header
+    bool verify() const {
+        return detail::checksum(m_data, m_size * sizeof(T)) == m_checksum;
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const VectorFileView& rhs) {
+        out << "[ ";
+        for (const T& element : rhs) {
+            out << element << " ";
+        }
+        return out << "]";
+    }
+
+private:
+    MappedFile m_mapping;
+    const T* m_data{nullptr};
+    std::size_t m_size{0};
+    std::uint64_t m_checksum{0};
+};
+
+// The elements of a file written by writeVectorFile or VectorFileWriter,
+// mapped rather than copied.
+template <typename T>
+VectorFileView<T> mapVectorFile(const std::filesystem::path& path) {
+    return VectorFileView<T>(path);
+}
+
+// Writes elements to a Vector file, buffered, e.g. as records arrive. The
+// header is rewritten by flush(), so a reader of the file sees the elements
+// up to the last flush, and a file left by a crash reopens in Append mode
+// with the elements of its last flush. close() flushes; the destructor
+// closes, but only close() reports errors.
+template <typename T>
+class VectorFileWriter {
+public:
+    explicit VectorFileWriter(const std::filesystem::path& path,
+                              VectorFileMode mode = VectorFileMode::Create)
+        : m_path{path} {
+        detail::checkFileElement<T>();
+        if (mode == VectorFileMode::Append && std::filesystem::exists(path)) {
+            openForAppend();
+        } else {
+            m_file.open(path, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+            if (!m_file) detail::fileFailure("Cannot create", path);
+            writeHeader();
+            const char zeros[detail::VECTOR_FILE_DATA_OFFSET - sizeof(VectorFileHeader)]{};
+            m_file.write(zeros, sizeof zeros);
+        }
+    }
+
+    VectorFileWriter(const VectorFileWriter&) = delete;
+    VectorFileWriter& operator=(const VectorFileWriter&) = delete;
+
+    ~VectorFileWriter() {
+        try {
+            close();
+        } catch (...) {
+        }
+    }
+
+    // elements written so far, flushed or not
+    std::size_t size() const {
+        return m_count;
+    }
+
+    void push_back(const T& element) {
+        append(std::span<const T>(&element, 1));
+    }
+
+    void append(std::span<const T> elements) {
+        if (!m_file.is_open()) throw std::logic_error("VectorFileWriter is closed");
+        const std::size_t bytes = elements.size_bytes();
+        m_file.write(reinterpret_cast<const char*>(elements.data()),
+                     static_cast<std::streamsize>(bytes));
+        if (!m_file) detail::fileFailure("Cannot write", m_path);
+        m_checksum = detail::checksum(elements.data(), bytes, m_checksum);
+        m_count += elements.size();
+    }
+
+    // makes the elements written so far part of the file
+    void flush() {
+        if (!m_file.is_open()) return;
+        m_file.flush();
+        const auto end = m_file.tellp();
+        m_file.seekp(0);
+        writeHeader();
+        m_file.seekp(end);
+        m_file.flush();
+        if (!m_file) detail::fileFailure("Cannot write", m_path);
+    }
+
+    void close() {
+        if (!m_file.is_open()) return;
+        flush();
+        m_file.close();
+    }
+
+private:
+    void writeHeader() {
+        const VectorFileHeader header = detail::makeFileHeader<T>(m_count, m_checksum);
+        m_file.write(reinterpret_cast<const char*>(&header), sizeof header);
+    }
+
+    // takes the flushed elements as they are, dropping a torn tail
+    void openForAppend() {
+        {
+            const VectorFileView<T> existing(m_path);
+            if (!existing.verify()) throw std::runtime_error("Vector file checksum mismatch");
+            m_count = existing.size();
+            m_checksum = existing.checksum();
+        }
+        std::filesystem::resize_file(m_path, detail::VECTOR_FILE_DATA_OFFSET + m_count * sizeof(T));
+        m_file.open(m_path, std::ios::binary | std::ios::in | std::ios::out);
+        if (!m_file) detail::fileFailure("Cannot open", m_path);
+        m_file.seekp(0, std::ios::end);
+    }
+
+    std::filesystem::path m_path;
+    std::fstream m_file;
+    std::size_t m_count{0};
+    std::uint64_t m_checksum{detail::FNV_OFFSET};
+};
+
+// Writes elements as a complete Vector file. The file is built next to
+// path and renamed over it, so readers never see a half-written file; if
+// writing fails, the partial file is removed and path is left as it was.
+template <typename T>
+void writeVectorFile(const std::filesystem::path& path, std::span<const T> elements) {
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+    try {
+        VectorFileWriter<T> writer(temporary);
+        writer.append(elements);
+        writer.close();
+        std::filesystem::rename(temporary, path);
+    } catch (...) {
+        std::error_code ignored;
+        std::filesystem::remove(temporary, ignored);
+        throw;
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+void writeVectorFile(const std::filesystem::path& path, const Vector<T, Alloc, Growth>& vector) {
+    writeVectorFile(path, std::span<const T>(vector.data(), vector.size()));
+}
+
+// Loads a Vector file into memory with one copy, after checking the checksum.
+template <typename T, typename Alloc = std::allocator<T>, typename Growth = growth::Double>
+Vector<T, Alloc, Growth> readVectorFile(const std::filesystem::path& path) {
+    const VectorFileView<T> view(path);
+    if (!view.verify()) throw std::runtime_error("Vector file checksum mismatch");
+    Vector<T, Alloc, Growth> result;
+    result.assign_range(view);
+    return result;
+}